@@ -0,0 +1,151 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_ccu4.h: Host replacement for the XMCLib CCU4 driver
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_CCU4_H
+#define XMC_CCU4_H
+
+#include "xmc_common.h"
+
+// Slices only store what was written to them, there is no timer running.
+// The LED duty cycles can be inspected through the compare values.
+typedef struct {
+	uint32_t period;
+	uint32_t compare;
+	uint32_t timer;
+	uint32_t events;
+	bool running;
+} XMC_CCU4_SLICE_t;
+
+typedef struct {
+	XMC_CCU4_SLICE_t *slice[4];
+	uint32_t shadow_transfer;
+} XMC_CCU4_MODULE_t;
+
+extern XMC_CCU4_SLICE_t host_ccu4_slice[2][4];
+extern XMC_CCU4_MODULE_t host_ccu4_module[2];
+
+#define CCU40      (&host_ccu4_module[0])
+#define CCU41      (&host_ccu4_module[1])
+#define CCU40_CC40 (&host_ccu4_slice[0][0])
+#define CCU40_CC41 (&host_ccu4_slice[0][1])
+#define CCU40_CC42 (&host_ccu4_slice[0][2])
+#define CCU40_CC43 (&host_ccu4_slice[0][3])
+#define CCU41_CC40 (&host_ccu4_slice[1][0])
+#define CCU41_CC41 (&host_ccu4_slice[1][1])
+#define CCU41_CC42 (&host_ccu4_slice[1][2])
+#define CCU41_CC43 (&host_ccu4_slice[1][3])
+
+#define XMC_CCU4_SHADOW_TRANSFER_SLICE_0           (1U << 0)
+#define XMC_CCU4_SHADOW_TRANSFER_PRESCALER_SLICE_0 (1U << 1)
+#define XMC_CCU4_SHADOW_TRANSFER_SLICE_1           (1U << 4)
+#define XMC_CCU4_SHADOW_TRANSFER_SLICE_2           (1U << 8)
+#define XMC_CCU4_SHADOW_TRANSFER_SLICE_3           (1U << 12)
+
+typedef enum {
+	XMC_CCU4_SLICE_MCMS_ACTION_TRANSFER_PR_CR = 0,
+	XMC_CCU4_SLICE_MCMS_ACTION_TRANSFER_PR_CR_PCMP = 1,
+	XMC_CCU4_SLICE_MCMS_ACTION_TRANSFER_PR_CR_PCMP_DIT = 3,
+} XMC_CCU4_SLICE_MCMS_ACTION_t;
+
+typedef enum {
+	XMC_CCU4_SLICE_TIMER_COUNT_MODE_EA = 0,
+	XMC_CCU4_SLICE_TIMER_COUNT_MODE_CA = 1,
+} XMC_CCU4_SLICE_TIMER_COUNT_MODE_t;
+
+typedef enum {
+	XMC_CCU4_SLICE_PRESCALER_MODE_NORMAL = 0,
+	XMC_CCU4_SLICE_PRESCALER_MODE_FLOAT  = 1,
+} XMC_CCU4_SLICE_PRESCALER_MODE_t;
+
+typedef enum {
+	XMC_CCU4_SLICE_OUTPUT_PASSIVE_LEVEL_LOW  = 0,
+	XMC_CCU4_SLICE_OUTPUT_PASSIVE_LEVEL_HIGH = 1,
+} XMC_CCU4_SLICE_OUTPUT_PASSIVE_LEVEL_t;
+
+typedef enum {
+	XMC_CCU4_SLICE_PRESCALER_1 = 0,
+	XMC_CCU4_SLICE_PRESCALER_2,
+	XMC_CCU4_SLICE_PRESCALER_4,
+	XMC_CCU4_SLICE_PRESCALER_8,
+	XMC_CCU4_SLICE_PRESCALER_16,
+	XMC_CCU4_SLICE_PRESCALER_32,
+	XMC_CCU4_SLICE_PRESCALER_64,
+	XMC_CCU4_SLICE_PRESCALER_128,
+	XMC_CCU4_SLICE_PRESCALER_256,
+	XMC_CCU4_SLICE_PRESCALER_512,
+	XMC_CCU4_SLICE_PRESCALER_1024,
+	XMC_CCU4_SLICE_PRESCALER_2048,
+	XMC_CCU4_SLICE_PRESCALER_4096,
+	XMC_CCU4_SLICE_PRESCALER_8192,
+	XMC_CCU4_SLICE_PRESCALER_16384,
+	XMC_CCU4_SLICE_PRESCALER_32768,
+} XMC_CCU4_SLICE_PRESCALER_t;
+
+typedef enum {
+	XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH  = 0,
+	XMC_CCU4_SLICE_IRQ_ID_ONE_MATCH     = 1,
+	XMC_CCU4_SLICE_IRQ_ID_COMPARE_MATCH_UP = 2,
+} XMC_CCU4_SLICE_IRQ_ID_t;
+
+typedef enum {
+	XMC_CCU4_SLICE_SR_ID_0 = 0,
+	XMC_CCU4_SLICE_SR_ID_1,
+	XMC_CCU4_SLICE_SR_ID_2,
+	XMC_CCU4_SLICE_SR_ID_3,
+} XMC_CCU4_SLICE_SR_ID_t;
+
+typedef struct {
+	uint32_t timer_mode;
+	uint32_t monoshot;
+	uint32_t shadow_xfer_clear;
+	uint32_t dither_timer_period;
+	uint32_t dither_duty_cycle;
+	uint32_t prescaler_mode;
+	uint32_t mcm_enable;
+	uint32_t prescaler_initval;
+	uint32_t float_limit;
+	uint32_t dither_limit;
+	uint32_t passive_level;
+	uint32_t timer_concatenation;
+} XMC_CCU4_SLICE_COMPARE_CONFIG_t;
+
+static inline void XMC_CCU4_Init(XMC_CCU4_MODULE_t *const module, const XMC_CCU4_SLICE_MCMS_ACTION_t mcs_action) { (void)module; (void)mcs_action; }
+static inline void XMC_CCU4_StartPrescaler(XMC_CCU4_MODULE_t *const module) { (void)module; }
+static inline void XMC_CCU4_EnableClock(XMC_CCU4_MODULE_t *const module, const uint8_t slice_number) { (void)module; (void)slice_number; }
+static inline void XMC_CCU4_EnableShadowTransfer(XMC_CCU4_MODULE_t *const module, const uint32_t shadow_transfer_msk) { module->shadow_transfer |= shadow_transfer_msk; }
+
+static inline void XMC_CCU4_SLICE_CompareInit(XMC_CCU4_SLICE_t *const slice, const XMC_CCU4_SLICE_COMPARE_CONFIG_t *const compare_init) { (void)slice; (void)compare_init; }
+static inline void XMC_CCU4_SLICE_SetTimerPeriodMatch(XMC_CCU4_SLICE_t *const slice, const uint16_t period_val) { slice->period = period_val; }
+static inline uint16_t XMC_CCU4_SLICE_GetTimerPeriodMatch(const XMC_CCU4_SLICE_t *const slice) { return (uint16_t)slice->period; }
+static inline void XMC_CCU4_SLICE_SetTimerCompareMatch(XMC_CCU4_SLICE_t *const slice, const uint16_t compare_val) { slice->compare = compare_val; }
+static inline uint16_t XMC_CCU4_SLICE_GetTimerCompareMatch(const XMC_CCU4_SLICE_t *const slice) { return (uint16_t)slice->compare; }
+static inline void XMC_CCU4_SLICE_SetTimerValue(XMC_CCU4_SLICE_t *const slice, const uint16_t timer_val) { slice->timer = timer_val; }
+static inline uint16_t XMC_CCU4_SLICE_GetTimerValue(const XMC_CCU4_SLICE_t *const slice) { return (uint16_t)slice->timer; }
+static inline void XMC_CCU4_SLICE_SetPrescaler(XMC_CCU4_SLICE_t *const slice, const XMC_CCU4_SLICE_PRESCALER_t div_val) { (void)slice; (void)div_val; }
+static inline void XMC_CCU4_SLICE_StartTimer(XMC_CCU4_SLICE_t *const slice) { slice->running = true; }
+static inline void XMC_CCU4_SLICE_StopTimer(XMC_CCU4_SLICE_t *const slice) { slice->running = false; }
+static inline void XMC_CCU4_SLICE_ClearTimer(XMC_CCU4_SLICE_t *const slice) { slice->timer = 0; }
+static inline void XMC_CCU4_SLICE_EnableEvent(XMC_CCU4_SLICE_t *const slice, const XMC_CCU4_SLICE_IRQ_ID_t event) { slice->events |= (1U << event); }
+static inline void XMC_CCU4_SLICE_DisableEvent(XMC_CCU4_SLICE_t *const slice, const XMC_CCU4_SLICE_IRQ_ID_t event) { slice->events &= ~(1U << event); }
+static inline void XMC_CCU4_SLICE_ClearEvent(XMC_CCU4_SLICE_t *const slice, const XMC_CCU4_SLICE_IRQ_ID_t event) { (void)slice; (void)event; }
+static inline void XMC_CCU4_SLICE_SetInterruptNode(XMC_CCU4_SLICE_t *const slice, const XMC_CCU4_SLICE_IRQ_ID_t event, const XMC_CCU4_SLICE_SR_ID_t sr) { (void)slice; (void)event; (void)sr; }
+
+#endif
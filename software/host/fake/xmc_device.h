@@ -0,0 +1,71 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_device.h: Host replacement for the XMC1400 device and CMSIS core headers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_DEVICE_H
+#define XMC_DEVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#define XMC1400
+#define UC_FAMILY XMC1
+#define UC_SERIES XMC14
+
+#define __STATIC_INLINE static inline
+#define __IO volatile
+#define __I  volatile const
+#define __O  volatile
+
+#define __NOP()        do {} while(0)
+#define __DSB()        do {} while(0)
+#define __ISB()        do {} while(0)
+#define __disable_irq() do {} while(0)
+#define __enable_irq()  do {} while(0)
+
+typedef int IRQn_Type;
+
+typedef struct {
+	__IO uint32_t CTRL;
+	__IO uint32_t LOAD;
+	__IO uint32_t VAL;
+	__I  uint32_t CALIB;
+} SysTick_Type;
+
+// Every access to SysTick updates VAL from the host clock first,
+// so that SysTick->VAL behaves like the real down-counter.
+SysTick_Type *host_systick(void);
+#define SysTick (host_systick())
+
+extern uint32_t SystemCoreClock;
+
+// The host starts a 1kHz interval timer that calls SysTick_Handler,
+// SysTick_Config only changes the reload value.
+uint32_t SysTick_Config(uint32_t ticks);
+
+static inline void NVIC_EnableIRQ(IRQn_Type irqn)                         { (void)irqn; }
+static inline void NVIC_DisableIRQ(IRQn_Type irqn)                        { (void)irqn; }
+static inline void NVIC_SetPriority(IRQn_Type irqn, uint32_t priority)    { (void)irqn; (void)priority; }
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irqn)                   { (void)irqn; }
+static inline void NVIC_SystemReset(void)                                 { }
+
+#endif
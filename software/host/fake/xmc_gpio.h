@@ -0,0 +1,187 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_gpio.h: Host replacement for the XMCLib GPIO driver
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_GPIO_H
+#define XMC_GPIO_H
+
+#include "xmc_common.h"
+
+typedef struct {
+	uint32_t OUT;
+	uint32_t IN;
+	uint32_t output_mask;
+} XMC_GPIO_PORT_t;
+
+extern XMC_GPIO_PORT_t host_gpio_port[5];
+
+#define XMC_GPIO_PORT0 (&host_gpio_port[0])
+#define XMC_GPIO_PORT1 (&host_gpio_port[1])
+#define XMC_GPIO_PORT2 (&host_gpio_port[2])
+#define XMC_GPIO_PORT3 (&host_gpio_port[3])
+#define XMC_GPIO_PORT4 (&host_gpio_port[4])
+
+#define P0_0 XMC_GPIO_PORT0, 0U
+#define P0_1 XMC_GPIO_PORT0, 1U
+#define P0_2 XMC_GPIO_PORT0, 2U
+#define P0_3 XMC_GPIO_PORT0, 3U
+#define P0_4 XMC_GPIO_PORT0, 4U
+#define P0_5 XMC_GPIO_PORT0, 5U
+#define P0_6 XMC_GPIO_PORT0, 6U
+#define P0_7 XMC_GPIO_PORT0, 7U
+#define P0_8 XMC_GPIO_PORT0, 8U
+#define P0_9 XMC_GPIO_PORT0, 9U
+#define P0_10 XMC_GPIO_PORT0, 10U
+#define P0_11 XMC_GPIO_PORT0, 11U
+#define P0_12 XMC_GPIO_PORT0, 12U
+#define P0_13 XMC_GPIO_PORT0, 13U
+#define P0_14 XMC_GPIO_PORT0, 14U
+#define P0_15 XMC_GPIO_PORT0, 15U
+#define P1_0 XMC_GPIO_PORT1, 0U
+#define P1_1 XMC_GPIO_PORT1, 1U
+#define P1_2 XMC_GPIO_PORT1, 2U
+#define P1_3 XMC_GPIO_PORT1, 3U
+#define P1_4 XMC_GPIO_PORT1, 4U
+#define P1_5 XMC_GPIO_PORT1, 5U
+#define P1_6 XMC_GPIO_PORT1, 6U
+#define P1_7 XMC_GPIO_PORT1, 7U
+#define P1_8 XMC_GPIO_PORT1, 8U
+#define P1_9 XMC_GPIO_PORT1, 9U
+#define P1_10 XMC_GPIO_PORT1, 10U
+#define P1_11 XMC_GPIO_PORT1, 11U
+#define P1_12 XMC_GPIO_PORT1, 12U
+#define P1_13 XMC_GPIO_PORT1, 13U
+#define P1_14 XMC_GPIO_PORT1, 14U
+#define P1_15 XMC_GPIO_PORT1, 15U
+#define P2_0 XMC_GPIO_PORT2, 0U
+#define P2_1 XMC_GPIO_PORT2, 1U
+#define P2_2 XMC_GPIO_PORT2, 2U
+#define P2_3 XMC_GPIO_PORT2, 3U
+#define P2_4 XMC_GPIO_PORT2, 4U
+#define P2_5 XMC_GPIO_PORT2, 5U
+#define P2_6 XMC_GPIO_PORT2, 6U
+#define P2_7 XMC_GPIO_PORT2, 7U
+#define P2_8 XMC_GPIO_PORT2, 8U
+#define P2_9 XMC_GPIO_PORT2, 9U
+#define P2_10 XMC_GPIO_PORT2, 10U
+#define P2_11 XMC_GPIO_PORT2, 11U
+#define P2_12 XMC_GPIO_PORT2, 12U
+#define P2_13 XMC_GPIO_PORT2, 13U
+#define P2_14 XMC_GPIO_PORT2, 14U
+#define P2_15 XMC_GPIO_PORT2, 15U
+#define P3_0 XMC_GPIO_PORT3, 0U
+#define P3_1 XMC_GPIO_PORT3, 1U
+#define P3_2 XMC_GPIO_PORT3, 2U
+#define P3_3 XMC_GPIO_PORT3, 3U
+#define P3_4 XMC_GPIO_PORT3, 4U
+#define P3_5 XMC_GPIO_PORT3, 5U
+#define P3_6 XMC_GPIO_PORT3, 6U
+#define P3_7 XMC_GPIO_PORT3, 7U
+#define P3_8 XMC_GPIO_PORT3, 8U
+#define P3_9 XMC_GPIO_PORT3, 9U
+#define P3_10 XMC_GPIO_PORT3, 10U
+#define P3_11 XMC_GPIO_PORT3, 11U
+#define P3_12 XMC_GPIO_PORT3, 12U
+#define P3_13 XMC_GPIO_PORT3, 13U
+#define P3_14 XMC_GPIO_PORT3, 14U
+#define P3_15 XMC_GPIO_PORT3, 15U
+#define P4_0 XMC_GPIO_PORT4, 0U
+#define P4_1 XMC_GPIO_PORT4, 1U
+#define P4_2 XMC_GPIO_PORT4, 2U
+#define P4_3 XMC_GPIO_PORT4, 3U
+#define P4_4 XMC_GPIO_PORT4, 4U
+#define P4_5 XMC_GPIO_PORT4, 5U
+#define P4_6 XMC_GPIO_PORT4, 6U
+#define P4_7 XMC_GPIO_PORT4, 7U
+#define P4_8 XMC_GPIO_PORT4, 8U
+#define P4_9 XMC_GPIO_PORT4, 9U
+#define P4_10 XMC_GPIO_PORT4, 10U
+#define P4_11 XMC_GPIO_PORT4, 11U
+#define P4_12 XMC_GPIO_PORT4, 12U
+#define P4_13 XMC_GPIO_PORT4, 13U
+#define P4_14 XMC_GPIO_PORT4, 14U
+#define P4_15 XMC_GPIO_PORT4, 15U
+
+// Alternate functions are not emulated, only their names have to exist
+#define P0_15_AF_U0C0_DOUT0  0U
+#define P2_0_AF_U0C0_DOUT0   0U
+#define P2_12_AF_U1C1_DOUT0  0U
+#define P4_5_AF_U1C0_DOUT0   0U
+#define P4_6_AF_U1C0_SCLKOUT 0U
+
+typedef enum {
+	XMC_GPIO_MODE_INPUT_TRISTATE          = 0x00,
+	XMC_GPIO_MODE_INPUT_PULL_DOWN         = 0x08,
+	XMC_GPIO_MODE_INPUT_PULL_UP           = 0x10,
+	XMC_GPIO_MODE_OUTPUT_PUSH_PULL        = 0x80,
+	XMC_GPIO_MODE_OUTPUT_OPEN_DRAIN       = 0xC0,
+	XMC_GPIO_MODE_OUTPUT_ALT1             = 0x01,
+	XMC_GPIO_MODE_OUTPUT_ALT2             = 0x02,
+	XMC_GPIO_MODE_OUTPUT_ALT3             = 0x03,
+	XMC_GPIO_MODE_OUTPUT_ALT4             = 0x04,
+	XMC_GPIO_MODE_OUTPUT_ALT5             = 0x05,
+	XMC_GPIO_MODE_OUTPUT_ALT6             = 0x06,
+	XMC_GPIO_MODE_OUTPUT_ALT7             = 0x07,
+	XMC_GPIO_MODE_OUTPUT_ALT8             = 0x08,
+	XMC_GPIO_MODE_OUTPUT_ALT9             = 0x09,
+	XMC_GPIO_MODE_OUTPUT_PUSH_PULL_ALT6   = 0x86,
+	XMC_GPIO_MODE_OUTPUT_PUSH_PULL_ALT7   = 0x87,
+	XMC_GPIO_MODE_OUTPUT_PUSH_PULL_ALT9   = 0x89,
+	XMC_GPIO_MODE_OUTPUT_OPEN_DRAIN_ALT6  = 0xC6,
+	XMC_GPIO_MODE_OUTPUT_OPEN_DRAIN_ALT7  = 0xC7,
+} XMC_GPIO_MODE_t;
+
+typedef enum {
+	XMC_GPIO_OUTPUT_LEVEL_LOW  = 0x10000,
+	XMC_GPIO_OUTPUT_LEVEL_HIGH = 0x1,
+} XMC_GPIO_OUTPUT_LEVEL_t;
+
+typedef enum {
+	XMC_GPIO_INPUT_HYSTERESIS_STANDARD = 0,
+	XMC_GPIO_INPUT_HYSTERESIS_LARGE    = 1,
+} XMC_GPIO_INPUT_HYSTERESIS_t;
+
+typedef struct {
+	XMC_GPIO_MODE_t mode;
+	XMC_GPIO_INPUT_HYSTERESIS_t input_hysteresis;
+	XMC_GPIO_OUTPUT_LEVEL_t output_level;
+} XMC_GPIO_CONFIG_t;
+
+void XMC_GPIO_Init(XMC_GPIO_PORT_t *const port, const uint8_t pin, const XMC_GPIO_CONFIG_t *const config);
+void XMC_GPIO_SetMode(XMC_GPIO_PORT_t *const port, const uint8_t pin, const XMC_GPIO_MODE_t mode);
+
+static inline void XMC_GPIO_SetOutputHigh(XMC_GPIO_PORT_t *const port, const uint8_t pin) { port->OUT |=  (1U << pin); }
+static inline void XMC_GPIO_SetOutputLow(XMC_GPIO_PORT_t *const port, const uint8_t pin)  { port->OUT &= ~(1U << pin); }
+static inline void XMC_GPIO_ToggleOutput(XMC_GPIO_PORT_t *const port, const uint8_t pin)  { port->OUT ^=  (1U << pin); }
+static inline void XMC_GPIO_SetOutputLevel(XMC_GPIO_PORT_t *const port, const uint8_t pin, const XMC_GPIO_OUTPUT_LEVEL_t level) {
+	if(level == XMC_GPIO_OUTPUT_LEVEL_HIGH) {
+		XMC_GPIO_SetOutputHigh(port, pin);
+	} else {
+		XMC_GPIO_SetOutputLow(port, pin);
+	}
+}
+
+// Output pins read back their output level, input pins read the simulated input level
+static inline uint32_t XMC_GPIO_GetInput(XMC_GPIO_PORT_t *const port, const uint8_t pin) {
+	const uint32_t level = (port->output_mask & (1U << pin)) ? port->OUT : port->IN;
+	return (level >> pin) & 1U;
+}
+
+#endif
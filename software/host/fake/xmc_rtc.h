@@ -0,0 +1,57 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_rtc.h: Host replacement for the XMCLib RTC driver
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_RTC_H
+#define XMC_RTC_H
+
+#include "xmc_common.h"
+
+typedef enum {
+	XMC_RTC_STATUS_OK    = 0,
+	XMC_RTC_STATUS_ERROR = 1,
+	XMC_RTC_STATUS_BUSY  = 2,
+} XMC_RTC_STATUS_t;
+
+typedef struct {
+	uint8_t seconds;
+	uint8_t minutes;
+	uint8_t hours;
+	uint8_t days;
+	uint8_t daysofweek;
+	uint8_t month;
+	uint16_t year;
+} XMC_RTC_TIME_t;
+
+typedef struct {
+	XMC_RTC_TIME_t time;
+	uint16_t prescaler;
+} XMC_RTC_CONFIG_t;
+
+// The fake RTC runs from the host clock with an offset set by XMC_RTC_SetTime
+XMC_RTC_STATUS_t XMC_RTC_Init(const XMC_RTC_CONFIG_t *const config);
+void XMC_RTC_Start(void);
+void XMC_RTC_Stop(void);
+bool XMC_RTC_IsRunning(void);
+bool XMC_RTC_IsEnabled(void);
+void XMC_RTC_SetTime(const XMC_RTC_TIME_t *const time);
+void XMC_RTC_GetTime(XMC_RTC_TIME_t *const time);
+
+#endif
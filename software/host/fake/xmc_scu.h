@@ -0,0 +1,39 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_scu.h: Host replacement for the XMCLib SCU driver
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_SCU_H
+#define XMC_SCU_H
+
+#include "xmc_common.h"
+
+#define XMC_SCU_IRQCTRL_USIC0_SR2_IRQ17 0
+#define XMC_SCU_IRQCTRL_USIC0_SR3_IRQ18 0
+#define XMC_SCU_IRQCTRL_USIC1_SR0_IRQ9  0
+#define XMC_SCU_IRQCTRL_USIC1_SR1_IRQ10 0
+#define XMC_SCU_IRQCTRL_USIC1_SR2_IRQ11 0
+#define XMC_SCU_IRQCTRL_USIC1_SR3_IRQ12 0
+#define XMC_SCU_IRQCTRL_USIC1_SR4_IRQ13 0
+#define XMC_SCU_IRQCTRL_USIC1_SR5_IRQ14 0
+
+static inline void XMC_SCU_SetInterruptControl(const uint8_t irq_number, const uint32_t source) { (void)irq_number; (void)source; }
+static inline uint32_t XMC_SCU_CLOCK_GetPeripheralClockFrequency(void) { return SystemCoreClock; }
+
+#endif
@@ -0,0 +1,93 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_spi.h: Host replacement for the XMCLib SPI driver
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_SPI_H
+#define XMC_SPI_H
+
+#include "xmc_usic.h"
+
+#define XMC_SPI0_CH0 USIC0_CH0
+#define XMC_SPI0_CH1 USIC0_CH1
+#define XMC_SPI1_CH0 USIC1_CH0
+#define XMC_SPI1_CH1 USIC1_CH1
+
+typedef enum {
+	XMC_SPI_CH_INPUT_DIN0 = 0,
+	XMC_SPI_CH_INPUT_SLAVE_SCLKIN = 1,
+	XMC_SPI_CH_INPUT_SLAVE_SELIN = 2,
+	XMC_SPI_CH_INPUT_DIN1 = 3,
+	XMC_SPI_CH_INPUT_DIN2 = 4,
+	XMC_SPI_CH_INPUT_DIN3 = 5,
+} XMC_SPI_CH_INPUT_t;
+
+typedef enum {
+	XMC_SPI_CH_MODE_STANDARD = 0,
+	XMC_SPI_CH_MODE_STANDARD_HALFDUPLEX,
+	XMC_SPI_CH_MODE_DUAL,
+	XMC_SPI_CH_MODE_QUAD,
+} XMC_SPI_CH_MODE_t;
+
+typedef enum {
+	XMC_SPI_CH_STATUS_OK    = 0,
+	XMC_SPI_CH_STATUS_ERROR = 1,
+	XMC_SPI_CH_STATUS_BUSY  = 2,
+} XMC_SPI_CH_STATUS_t;
+
+typedef enum {
+	XMC_SPI_CH_BUS_MODE_MASTER = 0,
+	XMC_SPI_CH_BUS_MODE_SLAVE  = 1,
+} XMC_SPI_CH_BUS_MODE_t;
+
+typedef enum {
+	XMC_SPI_CH_SLAVE_SEL_INV_TO_MSLS = 0,
+	XMC_SPI_CH_SLAVE_SEL_SAME_AS_MSLS = 1,
+} XMC_SPI_CH_SLAVE_SEL_MSLS_INV_t;
+
+#define XMC_SPI_CH_SLAVE_SELECT_0 (1U << 16)
+
+#define XMC_SPI_CH_BRG_SHIFT_CLOCK_PASSIVE_LEVEL_0_DELAY_ENABLED  0
+#define XMC_SPI_CH_BRG_SHIFT_CLOCK_PASSIVE_LEVEL_1_DELAY_ENABLED  1
+#define XMC_SPI_CH_BRG_SHIFT_CLOCK_PASSIVE_LEVEL_0_DELAY_DISABLED 2
+#define XMC_SPI_CH_BRG_SHIFT_CLOCK_PASSIVE_LEVEL_1_DELAY_DISABLED 3
+#define XMC_SPI_CH_BRG_SHIFT_CLOCK_OUTPUT_SCLK 0
+
+typedef struct {
+	uint32_t baudrate;
+	XMC_SPI_CH_BUS_MODE_t bus_mode;
+	XMC_SPI_CH_SLAVE_SEL_MSLS_INV_t selo_inversion;
+	XMC_USIC_CH_PARITY_MODE_t parity_mode;
+} XMC_SPI_CH_CONFIG_t;
+
+static inline void XMC_SPI_CH_Init(XMC_USIC_CH_t *const channel, const XMC_SPI_CH_CONFIG_t *const config) { channel->BRG = config->baudrate; }
+static inline void XMC_SPI_CH_Start(XMC_USIC_CH_t *const channel) { (void)channel; }
+static inline XMC_SPI_CH_STATUS_t XMC_SPI_CH_Stop(XMC_USIC_CH_t *const channel) { (void)channel; return XMC_SPI_CH_STATUS_OK; }
+static inline XMC_SPI_CH_STATUS_t XMC_SPI_CH_SetBaudrate(XMC_USIC_CH_t *const channel, const uint32_t rate) { channel->BRG = rate; return XMC_SPI_CH_STATUS_OK; }
+static inline void XMC_SPI_CH_SetInputSource(XMC_USIC_CH_t *const channel, const XMC_SPI_CH_INPUT_t input, const uint8_t source) { (void)channel; (void)input; (void)source; }
+static inline void XMC_SPI_CH_SetBitOrderMsbFirst(XMC_USIC_CH_t *const channel) { (void)channel; }
+static inline void XMC_SPI_CH_SetWordLength(XMC_USIC_CH_t *const channel, const uint8_t word_length) { (void)channel; (void)word_length; }
+static inline void XMC_SPI_CH_SetFrameLength(XMC_USIC_CH_t *const channel, const uint8_t frame_length) { (void)channel; (void)frame_length; }
+static inline void XMC_SPI_CH_EnableSlaveSelect(XMC_USIC_CH_t *const channel, const uint32_t slave) { (void)channel; (void)slave; }
+static inline void XMC_SPI_CH_DisableSlaveSelect(XMC_USIC_CH_t *const channel) { (void)channel; }
+static inline void XMC_SPI_CH_ConfigureShiftClockOutput(XMC_USIC_CH_t *const channel, const uint32_t passive_level, const uint32_t clock_output) { (void)channel; (void)passive_level; (void)clock_output; }
+static inline void XMC_SPI_CH_EnableEvent(XMC_USIC_CH_t *const channel, const uint32_t event) { channel->CCR |= event; }
+static inline void XMC_SPI_CH_DisableEvent(XMC_USIC_CH_t *const channel, const uint32_t event) { channel->CCR &= ~event; }
+
+#endif
@@ -0,0 +1,85 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_uart.h: Host replacement for the XMCLib UART driver
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_UART_H
+#define XMC_UART_H
+
+#include "xmc_usic.h"
+
+#define XMC_UART0_CH0 USIC0_CH0
+#define XMC_UART0_CH1 USIC0_CH1
+#define XMC_UART1_CH0 USIC1_CH0
+#define XMC_UART1_CH1 USIC1_CH1
+
+typedef enum {
+	XMC_UART_CH_INPUT_RXD  = 0,
+	XMC_UART_CH_INPUT_RXD1 = 3,
+	XMC_UART_CH_INPUT_RXD2 = 5,
+} XMC_UART_CH_INPUT_t;
+
+typedef enum {
+	XMC_UART_CH_STATUS_OK    = 0,
+	XMC_UART_CH_STATUS_ERROR = 1,
+	XMC_UART_CH_STATUS_BUSY  = 2,
+} XMC_UART_CH_STATUS_t;
+
+#define XMC_UART_CH_EVENT_RECEIVE_START       (1U << 10)
+#define XMC_UART_CH_EVENT_DATA_LOST           (1U << 11)
+#define XMC_UART_CH_EVENT_TRANSMIT_SHIFT      (1U << 12)
+#define XMC_UART_CH_EVENT_TRANSMIT_BUFFER     (1U << 13)
+#define XMC_UART_CH_EVENT_STANDARD_RECEIVE    (1U << 14)
+#define XMC_UART_CH_EVENT_ALTERNATIVE_RECEIVE (1U << 15)
+#define XMC_UART_CH_EVENT_BAUD_RATE_GENERATOR (1U << 16)
+#define XMC_UART_CH_EVENT_FRAME_FINISHED      (1U << 17)
+
+#define XMC_UART_CH_STATUS_FLAG_TRANSMISSION_IDLE     (1U << 0)
+#define XMC_UART_CH_STATUS_FLAG_RECEPTION_IDLE        (1U << 1)
+#define XMC_UART_CH_STATUS_FLAG_TRANSMIT_FRAME_FINISHED (1U << 12)
+#define XMC_UART_CH_STATUS_FLAG_ALTERNATIVE_RECEIVE_INDICATION (1U << 15)
+
+#define XMC_UART_CH_INTERRUPT_NODE_POINTER_TRANSMIT_SHIFT 0
+#define XMC_UART_CH_INTERRUPT_NODE_POINTER_TRANSMIT_BUFFER 1
+#define XMC_UART_CH_INTERRUPT_NODE_POINTER_RECEIVE 2
+#define XMC_UART_CH_INTERRUPT_NODE_POINTER_ALTERNATE_RECEIVE 3
+#define XMC_UART_CH_INTERRUPT_NODE_POINTER_PROTOCOL 4
+
+typedef struct {
+	uint32_t baudrate;
+	uint8_t data_bits;
+	uint8_t frame_length;
+	uint8_t stop_bits;
+	uint8_t oversampling;
+	XMC_USIC_CH_PARITY_MODE_t parity_mode;
+} XMC_UART_CH_CONFIG_t;
+
+static inline void XMC_UART_CH_Init(XMC_USIC_CH_t *const channel, const XMC_UART_CH_CONFIG_t *const config) { channel->BRG = config->baudrate; }
+static inline void XMC_UART_CH_SetInputSource(XMC_USIC_CH_t *const channel, const XMC_UART_CH_INPUT_t input, const uint8_t source) { (void)channel; (void)input; (void)source; }
+static inline void XMC_UART_CH_Start(XMC_USIC_CH_t *const channel) { (void)channel; }
+static inline XMC_UART_CH_STATUS_t XMC_UART_CH_Stop(XMC_USIC_CH_t *const channel) { (void)channel; return XMC_UART_CH_STATUS_OK; }
+static inline void XMC_UART_CH_EnableEvent(XMC_USIC_CH_t *const channel, const uint32_t event) { channel->CCR |= event; }
+static inline void XMC_UART_CH_DisableEvent(XMC_USIC_CH_t *const channel, const uint32_t event) { channel->CCR &= ~event; }
+static inline void XMC_UART_CH_SetInterruptNodePointer(XMC_USIC_CH_t *const channel, const uint32_t interrupt_node, const uint32_t service_request) { (void)channel; (void)interrupt_node; (void)service_request; }
+static inline uint32_t XMC_UART_CH_GetStatusFlag(XMC_USIC_CH_t *const channel) { return channel->PSR; }
+static inline void XMC_UART_CH_ClearStatusFlag(XMC_USIC_CH_t *const channel, const uint32_t flag) { channel->PSR &= ~flag; }
+static inline void XMC_UART_CH_Transmit(XMC_USIC_CH_t *const channel, const uint16_t data) { channel->IN[0] = data; }
+static inline uint16_t XMC_UART_CH_GetReceivedData(XMC_USIC_CH_t *const channel) { return (uint16_t)channel->RBUF; }
+
+#endif
@@ -0,0 +1,154 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_usic.h: Host replacement for the XMCLib USIC driver
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_USIC_H
+#define XMC_USIC_H
+
+#include "xmc_common.h"
+
+// Register layout of a USIC channel. The fake only gives the registers
+// storage, data written to IN[] is counted and dropped and the receive
+// FIFO is always empty. This behaves like a bus without any device on it.
+typedef struct {
+	__IO uint32_t CCFG;
+	__IO uint32_t KSCFG;
+	__IO uint32_t FDR;
+	__IO uint32_t BRG;
+	__IO uint32_t INPR;
+	__IO uint32_t DX0CR;
+	__IO uint32_t DX1CR;
+	__IO uint32_t DX2CR;
+	__IO uint32_t DX3CR;
+	__IO uint32_t DX4CR;
+	__IO uint32_t DX5CR;
+	__IO uint32_t SCTR;
+	__IO uint32_t TCSR;
+	__IO uint32_t PCR;
+	__IO uint32_t CCR;
+	__IO uint32_t CMTR;
+	__IO uint32_t PSR;
+	__IO uint32_t PSCR;
+	__IO uint32_t RBUFSR;
+	__IO uint32_t RBUF;
+	__IO uint32_t RBUFD;
+	__IO uint32_t RBUF0;
+	__IO uint32_t RBUF1;
+	__IO uint32_t RBUF01SR;
+	__IO uint32_t FMR;
+	__IO uint32_t TBUF[32];
+	__IO uint32_t BYP;
+	__IO uint32_t BYPCR;
+	__IO uint32_t TBCTR;
+	__IO uint32_t RBCTR;
+	__IO uint32_t TRBPTR;
+	__IO uint32_t TRBSR;
+	__IO uint32_t TRBSCR;
+	__IO uint32_t OUTR;
+	__IO uint32_t OUTDR;
+	__IO uint32_t IN[32];
+} USIC_CH_TypeDef;
+
+typedef USIC_CH_TypeDef XMC_USIC_CH_t;
+
+extern XMC_USIC_CH_t host_usic_channel[2][2];
+
+#define USIC0_CH0 (&host_usic_channel[0][0])
+#define USIC0_CH1 (&host_usic_channel[0][1])
+#define USIC1_CH0 (&host_usic_channel[1][0])
+#define USIC1_CH1 (&host_usic_channel[1][1])
+
+#define USIC_CH_TRBSR_SRBI_Msk   (1U << 0)
+#define USIC_CH_TRBSR_RBERI_Msk  (1U << 1)
+#define USIC_CH_TRBSR_ARBI_Msk   (1U << 2)
+#define USIC_CH_TRBSR_REMPTY_Msk (1U << 3)
+#define USIC_CH_TRBSR_RFULL_Msk  (1U << 4)
+#define USIC_CH_TRBSR_RBUS_Msk   (1U << 5)
+#define USIC_CH_TRBSR_STBI_Msk   (1U << 8)
+#define USIC_CH_TRBSR_TBERI_Msk  (1U << 9)
+#define USIC_CH_TRBSR_TEMPTY_Msk (1U << 11)
+#define USIC_CH_TRBSR_TFULL_Msk  (1U << 12)
+#define USIC_CH_TRBSR_TBUS_Msk   (1U << 13)
+#define USIC_CH_TRBSR_RBFLVL_Pos 16U
+#define USIC_CH_TRBSR_RBFLVL_Msk (0x7FU << 16)
+#define USIC_CH_TRBSR_TBFLVL_Pos 24U
+#define USIC_CH_TRBSR_TBFLVL_Msk (0x7FU << 24)
+
+#define USIC_CH_PSR_ASCMode_TFF_Msk (1U << 12)
+#define USIC_CH_PSR_ASCMode_RFF_Msk (1U << 13)
+#define USIC_CH_PSR_ASCMode_TSIF_Msk (1U << 12)
+
+typedef enum {
+	XMC_USIC_CH_INPUT_DX0 = 0,
+	XMC_USIC_CH_INPUT_DX1,
+	XMC_USIC_CH_INPUT_DX2,
+	XMC_USIC_CH_INPUT_DX3,
+	XMC_USIC_CH_INPUT_DX4,
+	XMC_USIC_CH_INPUT_DX5,
+} XMC_USIC_CH_INPUT_t;
+
+typedef enum {
+	XMC_USIC_CH_PARITY_MODE_NONE = 0,
+	XMC_USIC_CH_PARITY_MODE_EVEN = 2,
+	XMC_USIC_CH_PARITY_MODE_ODD  = 3,
+} XMC_USIC_CH_PARITY_MODE_t;
+
+typedef enum {
+	XMC_USIC_CH_FIFO_DISABLED = 0,
+	XMC_USIC_CH_FIFO_SIZE_2WORDS,
+	XMC_USIC_CH_FIFO_SIZE_4WORDS,
+	XMC_USIC_CH_FIFO_SIZE_8WORDS,
+	XMC_USIC_CH_FIFO_SIZE_16WORDS,
+	XMC_USIC_CH_FIFO_SIZE_32WORDS,
+	XMC_USIC_CH_FIFO_SIZE_64WORDS,
+} XMC_USIC_CH_FIFO_SIZE_t;
+
+#define XMC_USIC_CH_TXFIFO_EVENT_CONF_STANDARD (1U << 30)
+#define XMC_USIC_CH_TXFIFO_EVENT_CONF_ERROR    (1U << 31)
+#define XMC_USIC_CH_RXFIFO_EVENT_CONF_STANDARD (1U << 28)
+#define XMC_USIC_CH_RXFIFO_EVENT_CONF_ERROR    (1U << 30)
+#define XMC_USIC_CH_RXFIFO_EVENT_CONF_ALTERNATE (1U << 31)
+
+#define XMC_USIC_CH_TXFIFO_INTERRUPT_NODE_POINTER_STANDARD 0
+#define XMC_USIC_CH_RXFIFO_INTERRUPT_NODE_POINTER_STANDARD 0
+#define XMC_USIC_CH_RXFIFO_INTERRUPT_NODE_POINTER_ALTERNATE 1
+#define XMC_USIC_CH_INTERRUPT_NODE_POINTER_PROTOCOL 2
+
+static inline void XMC_USIC_CH_SetInputSource(XMC_USIC_CH_t *const channel, const XMC_USIC_CH_INPUT_t input, const uint8_t source) { (void)channel; (void)input; (void)source; }
+static inline void XMC_USIC_CH_TXFIFO_Configure(XMC_USIC_CH_t *const channel, const uint32_t data_pointer, const XMC_USIC_CH_FIFO_SIZE_t size, const uint32_t limit) { (void)data_pointer; (void)size; (void)limit; channel->TRBSR |= USIC_CH_TRBSR_TEMPTY_Msk; }
+static inline void XMC_USIC_CH_RXFIFO_Configure(XMC_USIC_CH_t *const channel, const uint32_t data_pointer, const XMC_USIC_CH_FIFO_SIZE_t size, const uint32_t limit) { (void)data_pointer; (void)size; (void)limit; channel->TRBSR |= USIC_CH_TRBSR_REMPTY_Msk; }
+static inline void XMC_USIC_CH_TXFIFO_SetInterruptNodePointer(XMC_USIC_CH_t *const channel, const uint32_t interrupt_node, const uint32_t service_request) { (void)channel; (void)interrupt_node; (void)service_request; }
+static inline void XMC_USIC_CH_RXFIFO_SetInterruptNodePointer(XMC_USIC_CH_t *const channel, const uint32_t interrupt_node, const uint32_t service_request) { (void)channel; (void)interrupt_node; (void)service_request; }
+static inline void XMC_USIC_CH_SetInterruptNodePointer(XMC_USIC_CH_t *const channel, const uint32_t interrupt_node, const uint32_t service_request) { (void)channel; (void)interrupt_node; (void)service_request; }
+static inline void XMC_USIC_CH_TXFIFO_EnableEvent(XMC_USIC_CH_t *const channel, const uint32_t event) { channel->TBCTR |= event; }
+static inline void XMC_USIC_CH_TXFIFO_DisableEvent(XMC_USIC_CH_t *const channel, const uint32_t event) { channel->TBCTR &= ~event; }
+static inline void XMC_USIC_CH_RXFIFO_EnableEvent(XMC_USIC_CH_t *const channel, const uint32_t event) { channel->RBCTR |= event; }
+static inline void XMC_USIC_CH_RXFIFO_DisableEvent(XMC_USIC_CH_t *const channel, const uint32_t event) { channel->RBCTR &= ~event; }
+static inline void XMC_USIC_CH_TXFIFO_Flush(XMC_USIC_CH_t *const channel) { channel->TRBSR |= USIC_CH_TRBSR_TEMPTY_Msk; }
+static inline void XMC_USIC_CH_RXFIFO_Flush(XMC_USIC_CH_t *const channel) { channel->TRBSR |= USIC_CH_TRBSR_REMPTY_Msk; }
+static inline bool XMC_USIC_CH_TXFIFO_IsFull(XMC_USIC_CH_t *const channel) { (void)channel; return false; }
+static inline bool XMC_USIC_CH_TXFIFO_IsEmpty(XMC_USIC_CH_t *const channel) { (void)channel; return true; }
+static inline bool XMC_USIC_CH_RXFIFO_IsFull(XMC_USIC_CH_t *const channel) { (void)channel; return false; }
+static inline bool XMC_USIC_CH_RXFIFO_IsEmpty(XMC_USIC_CH_t *const channel) { (void)channel; return true; }
+static inline uint16_t XMC_USIC_CH_RXFIFO_GetData(XMC_USIC_CH_t *const channel) { return (uint16_t)channel->OUTR; }
+static inline void XMC_USIC_CH_TXFIFO_PutData(XMC_USIC_CH_t *const channel, const uint16_t data) { channel->IN[0] = data; }
+static inline void XMC_USIC_CH_TriggerServiceRequest(XMC_USIC_CH_t *const channel, const uint32_t service_request) { (void)channel; (void)service_request; }
+
+#endif
@@ -0,0 +1,69 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * xmc_vadc.h: Host replacement for the XMCLib VADC driver
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef XMC_VADC_H
+#define XMC_VADC_H
+
+#include "xmc_common.h"
+
+typedef struct {
+	uint32_t result[16];
+} XMC_VADC_GROUP_t;
+
+typedef struct {
+	uint32_t dummy;
+} XMC_VADC_GLOBAL_t;
+
+extern XMC_VADC_GROUP_t host_vadc_group[2];
+extern XMC_VADC_GLOBAL_t host_vadc_global;
+
+#define VADC     (&host_vadc_global)
+#define VADC_G0  (&host_vadc_group[0])
+#define VADC_G1  (&host_vadc_group[1])
+
+typedef uint16_t XMC_VADC_RESULT_SIZE_t;
+
+// Configuration structs are accepted as opaque blobs, the fake ADC only knows results
+typedef struct { uint32_t data[8]; } XMC_VADC_GLOBAL_CONFIG_t;
+typedef struct { uint32_t data[8]; } XMC_VADC_GROUP_CONFIG_t;
+typedef struct { uint32_t data[8]; } XMC_VADC_CHANNEL_CONFIG_t;
+typedef struct { uint32_t data[8]; } XMC_VADC_RESULT_CONFIG_t;
+typedef struct { uint32_t data[8]; } XMC_VADC_BACKGROUND_CONFIG_t;
+typedef struct { uint32_t data[8]; } XMC_VADC_QUEUE_CONFIG_t;
+typedef struct { uint32_t data[8]; } XMC_VADC_QUEUE_ENTRY_t;
+typedef struct { uint32_t data[8]; } XMC_VADC_GLOBAL_CLASS_t;
+
+static inline void XMC_VADC_GLOBAL_Init(XMC_VADC_GLOBAL_t *const global_ptr, const XMC_VADC_GLOBAL_CONFIG_t *config) { (void)global_ptr; (void)config; }
+static inline void XMC_VADC_GLOBAL_StartupCalibration(XMC_VADC_GLOBAL_t *const global_ptr) { (void)global_ptr; }
+static inline void XMC_VADC_GROUP_Init(XMC_VADC_GROUP_t *const group_ptr, const XMC_VADC_GROUP_CONFIG_t *config) { (void)group_ptr; (void)config; }
+static inline void XMC_VADC_GROUP_SetPowerMode(XMC_VADC_GROUP_t *const group_ptr, const uint32_t power_mode) { (void)group_ptr; (void)power_mode; }
+static inline void XMC_VADC_GROUP_ChannelInit(XMC_VADC_GROUP_t *const group_ptr, const uint32_t ch_num, const XMC_VADC_CHANNEL_CONFIG_t *config) { (void)group_ptr; (void)ch_num; (void)config; }
+static inline void XMC_VADC_GROUP_ResultInit(XMC_VADC_GROUP_t *const group_ptr, const uint32_t res_reg_num, const XMC_VADC_RESULT_CONFIG_t *config) { (void)group_ptr; (void)res_reg_num; (void)config; }
+static inline void XMC_VADC_GLOBAL_BackgroundInit(XMC_VADC_GLOBAL_t *const global_ptr, const XMC_VADC_BACKGROUND_CONFIG_t *config) { (void)global_ptr; (void)config; }
+static inline void XMC_VADC_GLOBAL_BackgroundAddChannelToSequence(XMC_VADC_GLOBAL_t *const global_ptr, const uint32_t grp_num, const uint32_t ch_num) { (void)global_ptr; (void)grp_num; (void)ch_num; }
+static inline void XMC_VADC_GLOBAL_BackgroundTriggerConversion(XMC_VADC_GLOBAL_t *const global_ptr) { (void)global_ptr; }
+static inline void XMC_VADC_GROUP_QueueInit(XMC_VADC_GROUP_t *const group_ptr, const XMC_VADC_QUEUE_CONFIG_t *config) { (void)group_ptr; (void)config; }
+static inline void XMC_VADC_GROUP_QueueInsertChannel(XMC_VADC_GROUP_t *const group_ptr, const XMC_VADC_QUEUE_ENTRY_t entry) { (void)group_ptr; (void)entry; }
+static inline void XMC_VADC_GROUP_QueueTriggerConversion(XMC_VADC_GROUP_t *const group_ptr) { (void)group_ptr; }
+static inline XMC_VADC_RESULT_SIZE_t XMC_VADC_GROUP_GetResult(XMC_VADC_GROUP_t *const group_ptr, const uint32_t res_reg) { return (XMC_VADC_RESULT_SIZE_t)group_ptr->result[res_reg]; }
+static inline uint32_t XMC_VADC_GROUP_GetDetailedResult(XMC_VADC_GROUP_t *const group_ptr, const uint32_t res_reg) { return group_ptr->result[res_reg] | (1U << 31); }
+
+#endif
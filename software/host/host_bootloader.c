@@ -0,0 +1,250 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * host_bootloader.c: Host replacement for the bootloader/SPITFP side of the firmware
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+// On the WEM the bootloader receives TFP messages over SPITFP and calls
+// handle_message. Here the messages are replayed from a workload file
+// (raw TFP messages back to back, as the tester scripts would send them)
+// and everything the firmware sends is counted and optionally written
+// to an output file.
+//
+// Environment:
+// WEM_HOST_WORKLOAD: File with the TFP requests to replay (optional)
+// WEM_HOST_OUTPUT:   File that all responses and callbacks are written to (optional)
+// WEM_HOST_LOOPS:    Number of main loop iterations before exit (default 100000)
+// WEM_HOST_LINK_BPS: Emulated SPITFP throughput in bytes/s, 0 = unlimited (default 0)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "configs/config.h"
+
+#include "bricklib2/bootloader/bootloader.h"
+#include "bricklib2/protocols/tfp/tfp.h"
+#include "bricklib2/hal/system_timer/system_timer.h"
+#include "bricklib2/utility/util_definitions.h"
+
+#include "communication.h"
+#include "profiler.h"
+
+#define HOST_BOOTLOADER_UID         0x12345678
+#define HOST_BOOTLOADER_MESSAGE_MAX 80
+#define HOST_BOOTLOADER_EEPROM_PAGES 4
+
+BootloaderStatus bootloader_status;
+
+typedef struct {
+	FILE *workload;
+	FILE *output;
+	uint32_t loops;
+	uint32_t loops_max;
+	uint32_t link_bytes_per_s;
+	uint64_t link_busy_until_us;
+
+	uint32_t requests;
+	uint32_t responses;
+	uint32_t errors;
+	uint32_t callbacks;
+	uint64_t bytes_out;
+	uint64_t handle_message_cycles;
+
+	uint32_t eeprom[HOST_BOOTLOADER_EEPROM_PAGES][64];
+} HostBootloader;
+
+static HostBootloader host_bootloader;
+
+static uint64_t host_bootloader_get_us(void) {
+	// 32 bit ms counter plus SysTick fraction, good enough for link pacing
+	return (uint64_t)system_timer_get_ms()*1000 + (SysTick->LOAD - SysTick->VAL)/(SystemCoreClock/1000000);
+}
+
+static uint32_t host_bootloader_getenv_u32(const char *name, const uint32_t default_value) {
+	const char *value = getenv(name);
+	if(value == NULL) {
+		return default_value;
+	}
+
+	return (uint32_t)strtoul(value, NULL, 0);
+}
+
+static void host_bootloader_output(const uint8_t *data, const uint8_t length) {
+	host_bootloader.bytes_out += length;
+	if(host_bootloader.output != NULL) {
+		fwrite(data, 1, length, host_bootloader.output);
+	}
+
+	if(host_bootloader.link_bytes_per_s > 0) {
+		// SPITFP adds 3 bytes (length, sequence number, checksum) to each message
+		const uint64_t now = host_bootloader_get_us();
+		const uint64_t start = MAX(now, host_bootloader.link_busy_until_us);
+		host_bootloader.link_busy_until_us = start + ((uint64_t)(length + 3))*1000000/host_bootloader.link_bytes_per_s;
+	}
+}
+
+static void host_bootloader_print_statistics(void) {
+	fprintf(stdout, "loops %u, requests %u, responses %u, errors %u, callbacks %u, bytes out %llu\n",
+	        host_bootloader.loops, host_bootloader.requests, host_bootloader.responses,
+	        host_bootloader.errors, host_bootloader.callbacks, (unsigned long long)host_bootloader.bytes_out);
+	if(host_bootloader.requests > 0) {
+		fprintf(stdout, "handle_message avg %u cycles\n", (uint32_t)(host_bootloader.handle_message_cycles/host_bootloader.requests));
+	}
+
+	static const char *names[PROFILER_TICK_NUM] = {
+		"bootloader", "communication", "io", "led", "rs485", "meter", "voltage", "date_time", "sd", "data_storage", "sd_queue", "energy_log", "voltage_monitor"
+	};
+
+	fprintf(stdout, "%14s %10s %8s %8s %8s\n", "tick", "count", "min us", "avg us", "max us");
+	for(uint8_t i = 0; i < PROFILER_TICK_NUM; i++) {
+		const ProfilerStatisticsUs s = profiler_get_statistics_us(&profiler.tick[i]);
+		fprintf(stdout, "%14s %10u %8u %8u %8u\n", names[i], s.count, s.min, s.avg, s.max);
+	}
+	const ProfilerStatisticsUs s = profiler_get_statistics_us(&profiler.loop);
+	fprintf(stdout, "%14s %10u %8u %8u %8u\n", "loop", s.count, s.min, s.avg, s.max);
+}
+
+static bool host_bootloader_read_request(uint8_t *message) {
+	if(host_bootloader.workload == NULL) {
+		return false;
+	}
+
+	if(fread(message, 1, sizeof(TFPMessageHeader), host_bootloader.workload) != sizeof(TFPMessageHeader)) {
+		return false;
+	}
+
+	const uint8_t length = ((TFPMessageHeader*)message)->length;
+	if((length < sizeof(TFPMessageHeader)) || (length > HOST_BOOTLOADER_MESSAGE_MAX)) {
+		fprintf(stderr, "Invalid message length %u in workload\n", length);
+		exit(1);
+	}
+
+	const size_t payload_length = length - sizeof(TFPMessageHeader);
+	return fread(message + sizeof(TFPMessageHeader), 1, payload_length, host_bootloader.workload) == payload_length;
+}
+
+static void host_bootloader_init(void) {
+	const char *workload = getenv("WEM_HOST_WORKLOAD");
+	if(workload != NULL) {
+		host_bootloader.workload = fopen(workload, "rb");
+		if(host_bootloader.workload == NULL) {
+			perror(workload);
+			exit(1);
+		}
+	}
+
+	const char *output = getenv("WEM_HOST_OUTPUT");
+	if(output != NULL) {
+		host_bootloader.output = fopen(output, "wb");
+		if(host_bootloader.output == NULL) {
+			perror(output);
+			exit(1);
+		}
+	}
+
+	host_bootloader.loops_max        = host_bootloader_getenv_u32("WEM_HOST_LOOPS", 100000);
+	host_bootloader.link_bytes_per_s = host_bootloader_getenv_u32("WEM_HOST_LINK_BPS", 0);
+}
+
+void bootloader_tick(void) {
+	if(host_bootloader.loops == 0) {
+		host_bootloader_init();
+	}
+
+	if(host_bootloader.loops++ >= host_bootloader.loops_max) {
+		host_bootloader_print_statistics();
+		if(host_bootloader.output != NULL) {
+			fclose(host_bootloader.output);
+		}
+		exit(0);
+	}
+
+	// Like SPITFP we handle at most one message per tick and only if
+	// the previous response has left the send buffer
+	if(!bootloader_spitfp_is_send_possible(&bootloader_status.st)) {
+		return;
+	}
+
+	uint8_t message[HOST_BOOTLOADER_MESSAGE_MAX];
+	uint8_t response[HOST_BOOTLOADER_MESSAGE_MAX];
+	if(!host_bootloader_read_request(message)) {
+		return;
+	}
+
+	// The bootloader prepares the response header from the request header
+	memcpy(response, message, sizeof(TFPMessageHeader));
+	((TFPMessageHeader*)response)->length = sizeof(TFPMessageHeader);
+
+	host_bootloader.requests++;
+	const uint32_t start = profiler_get_cycles();
+	const BootloaderHandleMessageResponse ret = handle_message(message, response);
+	host_bootloader.handle_message_cycles += profiler_get_cycles() - start;
+
+	switch(ret) {
+		case HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE: {
+			host_bootloader.responses++;
+			host_bootloader_output(response, ((TFPMessageHeader*)response)->length);
+			break;
+		}
+
+		case HANDLE_MESSAGE_RESPONSE_EMPTY: {
+			break;
+		}
+
+		default: {
+			host_bootloader.errors++;
+			break;
+		}
+	}
+}
+
+uint32_t bootloader_get_uid(void) {
+	return HOST_BOOTLOADER_UID;
+}
+
+bool bootloader_spitfp_is_send_possible(SPITFP *st) {
+	if(host_bootloader.link_bytes_per_s == 0) {
+		return true;
+	}
+
+	return host_bootloader_get_us() >= host_bootloader.link_busy_until_us;
+}
+
+void bootloader_spitfp_send_ack_and_message(BootloaderStatus *bs, uint8_t *data, uint8_t length) {
+	host_bootloader.callbacks++;
+	host_bootloader_output(data, length);
+}
+
+bool bootloader_read_eeprom_page(const uint32_t page_num, uint32_t *data) {
+	if(page_num >= HOST_BOOTLOADER_EEPROM_PAGES) {
+		return false;
+	}
+
+	memcpy(data, host_bootloader.eeprom[page_num], sizeof(host_bootloader.eeprom[page_num]));
+	return true;
+}
+
+bool bootloader_write_eeprom_page(const uint32_t page_num, uint32_t *data) {
+	if(page_num >= HOST_BOOTLOADER_EEPROM_PAGES) {
+		return false;
+	}
+
+	memcpy(host_bootloader.eeprom[page_num], data, sizeof(host_bootloader.eeprom[page_num]));
+	return true;
+}
@@ -0,0 +1,114 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * host_coop_task.c: Host replacement for the cooperative task switcher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+// On the WEM coop_task switches stacks in the PendSV handler. On the host
+// we use ucontext instead. The CoopTask struct from coop_task.h is only
+// used as a key, the host context lives in a small side table.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+#include "configs/config.h"
+
+#include "bricklib2/os/coop_task.h"
+#include "bricklib2/hal/system_timer/system_timer.h"
+
+#define HOST_COOP_TASK_MAX 8
+#define HOST_COOP_TASK_STACK_SIZE (256*1024)
+
+typedef struct {
+	CoopTask *task;
+	CoopTaskFunction function;
+	ucontext_t context;
+	ucontext_t caller;
+	uint8_t *stack;
+	bool done;
+} HostCoopTask;
+
+static HostCoopTask host_coop_task[HOST_COOP_TASK_MAX];
+static HostCoopTask *host_coop_task_current = NULL;
+
+static HostCoopTask *host_coop_task_get(CoopTask *task) {
+	for(uint8_t i = 0; i < HOST_COOP_TASK_MAX; i++) {
+		if(host_coop_task[i].task == task) {
+			return &host_coop_task[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void host_coop_task_entry(void) {
+	host_coop_task_current->function();
+	host_coop_task_current->done = true;
+	swapcontext(&host_coop_task_current->context, &host_coop_task_current->caller);
+}
+
+void coop_task_init(CoopTask *task, CoopTaskFunction function) {
+	HostCoopTask *hct = host_coop_task_get(task);
+	if(hct == NULL) {
+		hct = host_coop_task_get(NULL);
+		if(hct == NULL) {
+			fprintf(stderr, "Too many coop tasks\n");
+			exit(1);
+		}
+		hct->stack = malloc(HOST_COOP_TASK_STACK_SIZE);
+	}
+
+	hct->task     = task;
+	hct->function = function;
+	hct->done     = false;
+
+	getcontext(&hct->context);
+	hct->context.uc_stack.ss_sp   = hct->stack;
+	hct->context.uc_stack.ss_size = HOST_COOP_TASK_STACK_SIZE;
+	hct->context.uc_link          = NULL;
+	makecontext(&hct->context, host_coop_task_entry, 0);
+}
+
+void coop_task_tick(CoopTask *task) {
+	HostCoopTask *hct = host_coop_task_get(task);
+	if((hct == NULL) || hct->done) {
+		return;
+	}
+
+	host_coop_task_current = hct;
+	swapcontext(&hct->caller, &hct->context);
+	host_coop_task_current = NULL;
+}
+
+void coop_task_yield(void) {
+	HostCoopTask *hct = host_coop_task_current;
+	if(hct == NULL) {
+		return;
+	}
+
+	swapcontext(&hct->context, &hct->caller);
+	host_coop_task_current = hct;
+}
+
+void coop_task_sleep_ms(const uint32_t sleep) {
+	const uint32_t start = system_timer_get_ms();
+	while(!system_timer_is_time_elapsed_ms(start, sleep)) {
+		coop_task_yield();
+	}
+}
@@ -0,0 +1,186 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * host_hal.c: Host replacements for clocks, GPIO and the on-chip peripherals
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include "xmc_device.h"
+#include "xmc_gpio.h"
+#include "xmc_ccu4.h"
+#include "xmc_rtc.h"
+#include "xmc_vadc.h"
+#include "xmc_usic.h"
+
+// Implemented by bricklib2/hal/system_timer/system_timer.c
+void SysTick_Handler(void);
+
+uint32_t SystemCoreClock = 48000000;
+
+XMC_GPIO_PORT_t host_gpio_port[5];
+XMC_CCU4_SLICE_t host_ccu4_slice[2][4];
+XMC_CCU4_MODULE_t host_ccu4_module[2] = {
+	{{&host_ccu4_slice[0][0], &host_ccu4_slice[0][1], &host_ccu4_slice[0][2], &host_ccu4_slice[0][3]}, 0},
+	{{&host_ccu4_slice[1][0], &host_ccu4_slice[1][1], &host_ccu4_slice[1][2], &host_ccu4_slice[1][3]}, 0},
+};
+XMC_VADC_GROUP_t host_vadc_group[2];
+XMC_VADC_GLOBAL_t host_vadc_global;
+XMC_USIC_CH_t host_usic_channel[2][2];
+
+static SysTick_Type host_systick_registers;
+static volatile uint64_t host_systick_last_ns = 0;
+static int64_t host_rtc_offset = 0;
+static bool host_rtc_running = false;
+
+static uint64_t host_get_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// --- SysTick ---
+
+static void host_systick_signal(int signum) {
+	(void)signum;
+	host_systick_last_ns = host_get_ns();
+	SysTick_Handler();
+}
+
+SysTick_Type *host_systick(void) {
+	// Emulate the down-counter from the time since the last "interrupt"
+	const uint64_t elapsed_ns = host_get_ns() - host_systick_last_ns;
+	const uint64_t elapsed    = elapsed_ns*(SystemCoreClock/1000000)/1000;
+	const uint32_t load       = host_systick_registers.LOAD;
+
+	host_systick_registers.VAL = (elapsed >= load) ? 0 : (uint32_t)(load - elapsed);
+	return &host_systick_registers;
+}
+
+uint32_t SysTick_Config(uint32_t ticks) {
+	host_systick_registers.LOAD = ticks - 1;
+	return 0;
+}
+
+// On the WEM the bootloader configures SysTick before the firmware starts.
+// We do the same before main is called.
+__attribute__((constructor)) static void host_hal_init(void) {
+	host_systick_registers.LOAD = SystemCoreClock/1000 - 1;
+	host_systick_last_ns        = host_get_ns();
+
+	struct sigaction sa;
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = host_systick_signal;
+	sa.sa_flags   = SA_RESTART;
+	sigaction(SIGALRM, &sa, NULL);
+
+	const struct itimerval interval = {
+		.it_interval = {.tv_sec = 0, .tv_usec = 1000},
+		.it_value    = {.tv_sec = 0, .tv_usec = 1000},
+	};
+	setitimer(ITIMER_REAL, &interval, NULL);
+}
+
+// --- GPIO ---
+
+void XMC_GPIO_Init(XMC_GPIO_PORT_t *const port, const uint8_t pin, const XMC_GPIO_CONFIG_t *const config) {
+	XMC_GPIO_SetMode(port, pin, config->mode);
+	if(config->output_level == XMC_GPIO_OUTPUT_LEVEL_HIGH) {
+		port->OUT |= (1U << pin);
+	} else {
+		port->OUT &= ~(1U << pin);
+	}
+}
+
+void XMC_GPIO_SetMode(XMC_GPIO_PORT_t *const port, const uint8_t pin, const XMC_GPIO_MODE_t mode) {
+	if(((uint32_t)mode) & 0x80) {
+		port->output_mask |= (1U << pin);
+	} else {
+		port->output_mask &= ~(1U << pin);
+	}
+}
+
+// --- RTC ---
+
+static void host_rtc_time_to_tm(const XMC_RTC_TIME_t *const rtc_time, struct tm *tm) {
+	memset(tm, 0, sizeof(struct tm));
+	tm->tm_sec  = rtc_time->seconds;
+	tm->tm_min  = rtc_time->minutes;
+	tm->tm_hour = rtc_time->hours;
+	tm->tm_mday = rtc_time->days + 1; // XMC RTC days start at 0
+	tm->tm_mon  = rtc_time->month;    // XMC RTC months start at 0
+	tm->tm_year = rtc_time->year - 1900;
+}
+
+XMC_RTC_STATUS_t XMC_RTC_Init(const XMC_RTC_CONFIG_t *const config) {
+	XMC_RTC_SetTime(&config->time);
+	return XMC_RTC_STATUS_OK;
+}
+
+void XMC_RTC_Start(void) {
+	host_rtc_running = true;
+}
+
+void XMC_RTC_Stop(void) {
+	host_rtc_running = false;
+}
+
+bool XMC_RTC_IsRunning(void) {
+	return host_rtc_running;
+}
+
+bool XMC_RTC_IsEnabled(void) {
+	return true;
+}
+
+void XMC_RTC_SetTime(const XMC_RTC_TIME_t *const rtc_time) {
+	struct tm tm;
+	host_rtc_time_to_tm(rtc_time, &tm);
+	host_rtc_offset = (int64_t)timegm(&tm) - (int64_t)time(NULL);
+}
+
+void XMC_RTC_GetTime(XMC_RTC_TIME_t *const rtc_time) {
+	const time_t now = (time_t)((int64_t)time(NULL) + host_rtc_offset);
+	struct tm tm;
+	gmtime_r(&now, &tm);
+
+	rtc_time->seconds    = (uint8_t)tm.tm_sec;
+	rtc_time->minutes    = (uint8_t)tm.tm_min;
+	rtc_time->hours      = (uint8_t)tm.tm_hour;
+	rtc_time->days       = (uint8_t)(tm.tm_mday - 1);
+	rtc_time->daysofweek = (uint8_t)tm.tm_wday;
+	rtc_time->month      = (uint8_t)tm.tm_mon;
+	rtc_time->year       = (uint16_t)(tm.tm_year + 1900);
+}
+
+// --- uartbb (logging output) ---
+
+void uartbb_init(void) {
+}
+
+void uartbb_tx(const uint8_t value) {
+	fputc(value, stderr);
+}
+
+void uartbb_puts(const char *str) {
+	fputs(str, stderr);
+}
@@ -0,0 +1,86 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * host_sdmmc.c: File backed block device standing in for the SD card
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+// Implements the block interface of sdmmc.h on top of an image file, so
+// that sd.c and littlefs run unchanged. The image can be inspected
+// with lfs_mount.sh just like a real card.
+//
+// Environment:
+// WEM_HOST_SD_IMAGE:   Image file, created sparse if missing (default wem-sd.img)
+// WEM_HOST_SD_SECTORS: Number of 512 byte sectors of a new image (default 1GiB)
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "sdmmc.h"
+
+#define HOST_SDMMC_SECTOR_SIZE 512
+
+static FILE *host_sdmmc_image = NULL;
+
+SDMMCError sdmmc_init(void) {
+	if(host_sdmmc_image != NULL) {
+		return SDMMC_ERROR_OK;
+	}
+
+	const char *path = getenv("WEM_HOST_SD_IMAGE");
+	if(path == NULL) {
+		path = "wem-sd.img";
+	}
+
+	host_sdmmc_image = fopen(path, "r+b");
+	if(host_sdmmc_image == NULL) {
+		const char *sectors_env = getenv("WEM_HOST_SD_SECTORS");
+		const long sectors = (sectors_env == NULL) ? (1024L*1024L*2L) : strtol(sectors_env, NULL, 0);
+
+		host_sdmmc_image = fopen(path, "w+b");
+		if(host_sdmmc_image == NULL) {
+			perror(path);
+			exit(1);
+		}
+
+		// Write the last byte to give the sparse image its size
+		fseek(host_sdmmc_image, sectors*HOST_SDMMC_SECTOR_SIZE - 1, SEEK_SET);
+		fputc(0, host_sdmmc_image);
+		fflush(host_sdmmc_image);
+	}
+
+	return SDMMC_ERROR_OK;
+}
+
+SDMMCError sdmmc_read_block(const uint32_t sector, uint8_t *data) {
+	if((fseek(host_sdmmc_image, (long)sector*HOST_SDMMC_SECTOR_SIZE, SEEK_SET) != 0) ||
+	   (fread(data, 1, HOST_SDMMC_SECTOR_SIZE, host_sdmmc_image) != HOST_SDMMC_SECTOR_SIZE)) {
+		return SDMMC_ERROR_READ_BLOCK_TIMEOUT;
+	}
+
+	return SDMMC_ERROR_OK;
+}
+
+SDMMCError sdmmc_write_block(const uint32_t sector, const uint8_t *data) {
+	if((fseek(host_sdmmc_image, (long)sector*HOST_SDMMC_SECTOR_SIZE, SEEK_SET) != 0) ||
+	   (fwrite(data, 1, HOST_SDMMC_SECTOR_SIZE, host_sdmmc_image) != HOST_SDMMC_SECTOR_SIZE)) {
+		return SDMMC_ERROR_WRITE_BLOCK_TIMEOUT;
+	}
+
+	return SDMMC_ERROR_OK;
+}
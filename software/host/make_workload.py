@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Writes a workload file for the host build (WEM_HOST_WORKLOAD).
+# The file contains raw TFP requests back to back, the host bootloader
+# replays one request per main loop iteration.
+#
+# Usage: make_workload.py <output> [wallbox data points] [get_all_data_1 requests]
+
+import struct
+import sys
+
+UID = 0x12345678
+
+FUNCTION_GET_ALL_DATA_1 = 14
+FUNCTION_SET_SD_WALLBOX_DATA_POINT = 16
+FUNCTION_GET_SD_WALLBOX_DATA_POINTS = 17
+
+def message(fid, payload, seq):
+    # Sequence number in the upper 4 bit, response expected in bit 3
+    options = ((seq % 15 + 1) << 4) | (1 << 3)
+    return struct.pack('<IBBBB', UID, 8 + len(payload), fid, options, 0) + payload
+
+if __name__ == '__main__':
+    output = sys.argv[1]
+    data_points = int(sys.argv[2]) if len(sys.argv) > 2 else 288
+    all_data = int(sys.argv[3]) if len(sys.argv) > 3 else 1000
+
+    seq = 0
+    with open(output, 'wb') as f:
+        # One day of 5 minute data points for wallbox 1 ...
+        for i in range(data_points):
+            hour, minute = divmod((i % 288) * 5, 60)
+            payload = struct.pack('<IBBBBBBH', 1, 24, 1, 1 + i // 288, hour, minute, 0, i % 22000)
+            f.write(message(FUNCTION_SET_SD_WALLBOX_DATA_POINT, payload, seq))
+            seq += 1
+
+        # ... read it back as callback stream ...
+        payload = struct.pack('<IBBBBBH', 1, 24, 1, 1, 0, 0, min(data_points, 288))
+        f.write(message(FUNCTION_GET_SD_WALLBOX_DATA_POINTS, payload, seq))
+        seq += 1
+
+        # ... and poll like the ESP32 does
+        for i in range(all_data):
+            f.write(message(FUNCTION_GET_ALL_DATA_1, b'', seq))
+            seq += 1
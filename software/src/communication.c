@@ -21,6 +21,9 @@
 
 #include "communication.h"
 
+#include "configs/config.h"
+#include "configs/config_led.h"
+
 #include "bricklib2/utility/communication_callback.h"
 #include "bricklib2/protocols/tfp/tfp.h"
 #include "bricklib2/logging/logging.h"
@@ -36,12 +39,23 @@
 #include "sdmmc.h"
 #include "data_storage.h"
 #include "eeprom.h"
+#include "profiler.h"
+#include "sd_queue.h"
+#include "energy_log.h"
+#include "io_sequence.h"
+#include "voltage_monitor.h"
 
 #include "xmc_rtc.h"
 
 // SD lfs format bool is outside of struct to avoid it being overwritten during re-init of SD card
 extern bool sd_lfs_format;
 
+// Set by cancel_sd_data_points, the remaining chunks of the running stream of the type are dropped
+static bool sd_data_points_cancel[4] = {false, false, false, false};
+
+// Number of data elements in one callback chunk, offset and length of the low level callbacks are counted in elements
+#define SD_CB_CHUNK_LENGTH(cb) (sizeof((cb).data_chunk_data)/sizeof((cb).data_chunk_data[0]))
+
 static uint8_t get_sd_lfs_status(const uint8_t end, const uint8_t max_length) {
 	if(sd.sd_status != SDMMC_ERROR_OK) {
 		return WARP_ENERGY_MANAGER_DATA_STATUS_SD_ERROR;
@@ -100,48 +114,141 @@ static uint8_t get_amount_daily_status(uint8_t day, uint16_t amount) {
 	return WARP_ENERGY_MANAGER_DATA_STATUS_OK;
 }
 
+// All handlers as COMMUNICATION_FUNCTION: handler(message) and
+// COMMUNICATION_RESPONSE: handler(message, response)
+#define COMMUNICATION_HANDLERS(COMMUNICATION_FUNCTION, COMMUNICATION_RESPONSE) \
+	COMMUNICATION_FUNCTION(FID_SET_CONTACTOR,                              SetContactor,                          set_contactor) \
+	COMMUNICATION_RESPONSE(FID_GET_CONTACTOR,                              GetContactor,                          get_contactor) \
+	COMMUNICATION_FUNCTION(FID_SET_RGB_VALUE,                              SetRGBValue,                           set_rgb_value) \
+	COMMUNICATION_RESPONSE(FID_GET_RGB_VALUE,                              GetRGBValue,                           get_rgb_value) \
+	COMMUNICATION_RESPONSE(FID_GET_ENERGY_METER_VALUES,                    GetEnergyMeterValues,                  get_energy_meter_values) \
+	COMMUNICATION_RESPONSE(FID_GET_ENERGY_METER_DETAILED_VALUES_LOW_LEVEL, GetEnergyMeterDetailedValuesLowLevel,  get_energy_meter_detailed_values_low_level) \
+	COMMUNICATION_RESPONSE(FID_GET_ENERGY_METER_STATE,                     GetEnergyMeterState,                   get_energy_meter_state) \
+	COMMUNICATION_RESPONSE(FID_GET_INPUT,                                  GetInput,                              get_input) \
+	COMMUNICATION_FUNCTION(FID_SET_OUTPUT,                                 SetOutput,                             set_output) \
+	COMMUNICATION_RESPONSE(FID_GET_OUTPUT,                                 GetOutput,                             get_output) \
+	COMMUNICATION_RESPONSE(FID_GET_INPUT_VOLTAGE,                          GetInputVoltage,                       get_input_voltage) \
+	COMMUNICATION_RESPONSE(FID_GET_STATE,                                  GetState,                              get_state) \
+	COMMUNICATION_RESPONSE(FID_GET_UPTIME,                                 GetUptime,                             get_uptime) \
+	COMMUNICATION_RESPONSE(FID_GET_ALL_DATA_1,                             GetAllData1,                           get_all_data_1) \
+	COMMUNICATION_RESPONSE(FID_GET_SD_INFORMATION,                         GetSDInformation,                      get_sd_information) \
+	COMMUNICATION_RESPONSE(FID_SET_SD_WALLBOX_DATA_POINT,                  SetSDWallboxDataPoint,                 set_sd_wallbox_data_point) \
+	COMMUNICATION_RESPONSE(FID_GET_SD_WALLBOX_DATA_POINTS,                 GetSDWallboxDataPoints,                get_sd_wallbox_data_points) \
+	COMMUNICATION_RESPONSE(FID_SET_SD_WALLBOX_DAILY_DATA_POINT,            SetSDWallboxDailyDataPoint,            set_sd_wallbox_daily_data_point) \
+	COMMUNICATION_RESPONSE(FID_GET_SD_WALLBOX_DAILY_DATA_POINTS,           GetSDWallboxDailyDataPoints,           get_sd_wallbox_daily_data_points) \
+	COMMUNICATION_RESPONSE(FID_SET_SD_ENERGY_MANAGER_DATA_POINT,           SetSDEnergyManagerDataPoint,           set_sd_energy_manager_data_point) \
+	COMMUNICATION_RESPONSE(FID_GET_SD_ENERGY_MANAGER_DATA_POINTS,          GetSDEnergyManagerDataPoints,          get_sd_energy_manager_data_points) \
+	COMMUNICATION_RESPONSE(FID_SET_SD_ENERGY_MANAGER_DAILY_DATA_POINT,     SetSDEnergyManagerDailyDataPoint,      set_sd_energy_manager_daily_data_point) \
+	COMMUNICATION_RESPONSE(FID_GET_SD_ENERGY_MANAGER_DAILY_DATA_POINTS,    GetSDEnergyManagerDailyDataPoints,     get_sd_energy_manager_daily_data_points) \
+	COMMUNICATION_RESPONSE(FID_FORMAT_SD,                                  FormatSD,                              format_sd) \
+	COMMUNICATION_FUNCTION(FID_SET_DATE_TIME,                              SetDateTime,                           set_date_time) \
+	COMMUNICATION_RESPONSE(FID_GET_DATE_TIME,                              GetDateTime,                           get_date_time) \
+	COMMUNICATION_FUNCTION(FID_SET_LED_STATE,                              SetLEDState,                           set_led_state) \
+	COMMUNICATION_RESPONSE(FID_GET_LED_STATE,                              GetLEDState,                           get_led_state) \
+	COMMUNICATION_RESPONSE(FID_GET_DATA_STORAGE,                           GetDataStorage,                        get_data_storage) \
+	COMMUNICATION_FUNCTION(FID_SET_DATA_STORAGE,                           SetDataStorage,                        set_data_storage) \
+	COMMUNICATION_FUNCTION(FID_RESET_ENERGY_METER_RELATIVE_ENERGY,         ResetEnergyMeterRelativeEnergy,        reset_energy_meter_relative_energy) \
+	COMMUNICATION_RESPONSE(FID_GET_TICK_STATISTICS,                        GetTickStatistics,                     get_tick_statistics) \
+	COMMUNICATION_RESPONSE(FID_GET_LOOP_STATISTICS,                        GetLoopStatistics,                     get_loop_statistics) \
+	COMMUNICATION_FUNCTION(FID_RESET_TICK_STATISTICS,                      ResetTickStatistics,                   reset_tick_statistics) \
+	COMMUNICATION_RESPONSE(FID_SET_SD_WALLBOX_DATA_POINTS,                 SetSDWallboxDataPoints,                set_sd_wallbox_data_points) \
+	COMMUNICATION_RESPONSE(FID_GET_SD_QUEUE_STATUS,                        GetSDQueueStatus,                      get_sd_queue_status) \
+	COMMUNICATION_FUNCTION(FID_CANCEL_SD_DATA_POINTS,                      CancelSDDataPoints,                    cancel_sd_data_points) \
+	COMMUNICATION_RESPONSE(FID_GET_FID_STATISTICS,                         GetFIDStatistics,                      get_fid_statistics) \
+	COMMUNICATION_RESPONSE(FID_GET_ALL_DATA_CHANGES,                       GetAllDataChanges,                     get_all_data_changes) \
+	COMMUNICATION_FUNCTION(FID_SET_ENERGY_LOG_CONFIGURATION,               SetEnergyLogConfiguration,             set_energy_log_configuration) \
+	COMMUNICATION_RESPONSE(FID_GET_ENERGY_LOG_CONFIGURATION,               GetEnergyLogConfiguration,             get_energy_log_configuration) \
+	COMMUNICATION_FUNCTION(FID_SET_ENERGY_LOG_VALUES,                      SetEnergyLogValues,                    set_energy_log_values) \
+	COMMUNICATION_FUNCTION(FID_SET_ENERGY_LOG_DAILY_VALUES,                SetEnergyLogDailyValues,               set_energy_log_daily_values) \
+	COMMUNICATION_RESPONSE(FID_GET_ENERGY_LOG_STATE,                       GetEnergyLogState,                     get_energy_log_state) \
+	COMMUNICATION_RESPONSE(FID_START_IO_SEQUENCE,                          StartIOSequence,                       start_io_sequence) \
+	COMMUNICATION_FUNCTION(FID_ABORT_IO_SEQUENCE,                          AbortIOSequence,                       abort_io_sequence) \
+	COMMUNICATION_RESPONSE(FID_GET_IO_SEQUENCE_STATE,                      GetIOSequenceState,                    get_io_sequence_state) \
+	COMMUNICATION_FUNCTION(FID_SET_LED_SEQUENCE,                           SetLEDSequence,                        set_led_sequence) \
+	COMMUNICATION_RESPONSE(FID_GET_LED_SEQUENCE,                           GetLEDSequence,                        get_led_sequence) \
+	COMMUNICATION_FUNCTION(FID_SET_VOLTAGE_MONITOR_CONFIGURATION,          SetVoltageMonitorConfiguration,        set_voltage_monitor_configuration) \
+	COMMUNICATION_RESPONSE(FID_GET_VOLTAGE_MONITOR_CONFIGURATION,          GetVoltageMonitorConfiguration,        get_voltage_monitor_configuration) \
+	COMMUNICATION_RESPONSE(FID_GET_VOLTAGE_MONITOR_STATISTICS,             GetVoltageMonitorStatistics,           get_voltage_monitor_statistics) \
+	COMMUNICATION_FUNCTION(FID_RESET_FID_STATISTICS,                       ResetFIDStatistics,                    reset_fid_statistics)
+
+// Each handler gets a wrapper with the common signature, so that every handler
+// is called through a function pointer of its own type
+#define COMMUNICATION_WRAP_FUNCTION(fid, type, function) \
+	static BootloaderHandleMessageResponse function##_wrapper(const void *message, void *response) { \
+		return function((const type *)message); \
+	}
+#define COMMUNICATION_WRAP_RESPONSE(fid, type, function) \
+	static BootloaderHandleMessageResponse function##_wrapper(const void *message, void *response) { \
+		return function((const type *)message, (type##_Response *)response); \
+	}
+
+COMMUNICATION_HANDLERS(COMMUNICATION_WRAP_FUNCTION, COMMUNICATION_WRAP_RESPONSE)
+
+#define COMMUNICATION_ENTRY(fid, type, function) [fid] = {sizeof(type), function##_wrapper},
+
+// Indexed by FID, FIDs without handler (callbacks) have length 0
+static const CommunicationFunction communication_functions[COMMUNICATION_FID_NUM] = {
+	COMMUNICATION_HANDLERS(COMMUNICATION_ENTRY, COMMUNICATION_ENTRY)
+};
+
+#ifdef COMMUNICATION_FID_STATISTICS
+CommunicationFIDStatistics communication_fid_statistics[COMMUNICATION_FID_NUM];
+uint32_t communication_fid_histogram_limit[COMMUNICATION_FID_HISTOGRAM_BUCKETS-1];
+#endif
+
 BootloaderHandleMessageResponse handle_message(const void *message, void *response) {
 	led.connection_lost_time = system_timer_get_ms(); // Reset connection lost time with each message
 
 	const uint8_t length = ((TFPMessageHeader*)message)->length;
-	switch(tfp_get_fid_from_message(message)) {
-		case FID_SET_CONTACTOR:                              return length != sizeof(SetContactor)                         ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_contactor(message);
-		case FID_GET_CONTACTOR:                              return length != sizeof(GetContactor)                         ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_contactor(message, response);
-		case FID_SET_RGB_VALUE:                              return length != sizeof(SetRGBValue)                          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_rgb_value(message);
-		case FID_GET_RGB_VALUE:                              return length != sizeof(GetRGBValue)                          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_rgb_value(message, response);
-		case FID_GET_ENERGY_METER_VALUES:                    return length != sizeof(GetEnergyMeterValues)                 ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_energy_meter_values(message, response);
-		case FID_GET_ENERGY_METER_DETAILED_VALUES_LOW_LEVEL: return length != sizeof(GetEnergyMeterDetailedValuesLowLevel) ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_energy_meter_detailed_values_low_level(message, response);
-		case FID_GET_ENERGY_METER_STATE:                     return length != sizeof(GetEnergyMeterState)                  ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_energy_meter_state(message, response);
-		case FID_GET_INPUT:                                  return length != sizeof(GetInput)                             ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_input(message, response);
-		case FID_SET_OUTPUT:                                 return length != sizeof(SetOutput)                            ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_output(message);
-		case FID_GET_OUTPUT:                                 return length != sizeof(GetOutput)                            ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_output(message, response);
-		case FID_GET_INPUT_VOLTAGE:                          return length != sizeof(GetInputVoltage)                      ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_input_voltage(message, response);
-		case FID_GET_STATE:                                  return length != sizeof(GetState)                             ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_state(message, response);
-		case FID_GET_UPTIME:                                 return length != sizeof(GetUptime)                            ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_uptime(message, response);
-		case FID_GET_ALL_DATA_1:                             return length != sizeof(GetAllData1)                          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_all_data_1(message, response);
-		case FID_GET_SD_INFORMATION:                         return length != sizeof(GetSDInformation)                     ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_information(message, response);
-		case FID_SET_SD_WALLBOX_DATA_POINT:                  return length != sizeof(SetSDWallboxDataPoint)                ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_sd_wallbox_data_point(message, response);
-		case FID_GET_SD_WALLBOX_DATA_POINTS:                 return length != sizeof(GetSDWallboxDataPoints)               ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_wallbox_data_points(message, response);
-		case FID_SET_SD_WALLBOX_DAILY_DATA_POINT:            return length != sizeof(SetSDWallboxDailyDataPoint)           ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_sd_wallbox_daily_data_point(message, response);
-		case FID_GET_SD_WALLBOX_DAILY_DATA_POINTS:           return length != sizeof(GetSDWallboxDailyDataPoints)          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_wallbox_daily_data_points(message, response);
-		case FID_SET_SD_ENERGY_MANAGER_DATA_POINT:           return length != sizeof(SetSDEnergyManagerDataPoint)          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_sd_energy_manager_data_point(message, response);
-		case FID_GET_SD_ENERGY_MANAGER_DATA_POINTS:          return length != sizeof(GetSDEnergyManagerDataPoints)         ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_energy_manager_data_points(message, response);
-		case FID_SET_SD_ENERGY_MANAGER_DAILY_DATA_POINT:     return length != sizeof(SetSDEnergyManagerDailyDataPoint)     ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_sd_energy_manager_daily_data_point(message, response);
-		case FID_GET_SD_ENERGY_MANAGER_DAILY_DATA_POINTS:    return length != sizeof(GetSDEnergyManagerDailyDataPoints)    ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_energy_manager_daily_data_points(message, response);
-		case FID_FORMAT_SD:                                  return length != sizeof(FormatSD)                             ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : format_sd(message, response);
-		case FID_SET_DATE_TIME:                              return length != sizeof(SetDateTime)                          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_date_time(message);
-		case FID_GET_DATE_TIME:                              return length != sizeof(GetDateTime)                          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_date_time(message, response);
-		case FID_SET_LED_STATE:                              return length != sizeof(SetLEDState)                          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_led_state(message);
-		case FID_GET_LED_STATE:                              return length != sizeof(GetLEDState)                          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_led_state(message, response);
-		case FID_GET_DATA_STORAGE:                           return length != sizeof(GetDataStorage)                       ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_data_storage(message, response);
-		case FID_SET_DATA_STORAGE:                           return length != sizeof(SetDataStorage)                       ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_data_storage(message);
-		case FID_RESET_ENERGY_METER_RELATIVE_ENERGY:         return length != sizeof(ResetEnergyMeterRelativeEnergy)       ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : reset_energy_meter_relative_energy(message);
-		default: return HANDLE_MESSAGE_RESPONSE_NOT_SUPPORTED;
+	const uint8_t fid    = tfp_get_fid_from_message(message);
+	if((fid >= COMMUNICATION_FID_NUM) || (communication_functions[fid].length == 0)) {
+#ifdef COMMUNICATION_FID_STATISTICS
+		communication_fid_statistics[0].calls++; // FID 0 counts unknown FIDs
+#endif
+		return HANDLE_MESSAGE_RESPONSE_NOT_SUPPORTED;
+	}
+
+	const CommunicationFunction *function = &communication_functions[fid];
+#ifdef COMMUNICATION_FID_STATISTICS
+	CommunicationFIDStatistics *statistics = &communication_fid_statistics[fid];
+	statistics->calls++;
+#endif
+
+	if(length != function->length) {
+#ifdef COMMUNICATION_FID_STATISTICS
+		statistics->invalid_length++;
+#endif
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
 	}
+
+#ifdef COMMUNICATION_FID_STATISTICS
+	const uint32_t start = profiler_get_cycles();
+#endif
+
+	const BootloaderHandleMessageResponse ret = function->handler(message, response);
+
+#ifdef COMMUNICATION_FID_STATISTICS
+	const uint32_t cycles = profiler_get_cycles() - start;
+	if(cycles > statistics->max_cycles) {
+		statistics->max_cycles = cycles;
+	}
+
+	uint8_t bucket = 0;
+	while((bucket < (COMMUNICATION_FID_HISTOGRAM_BUCKETS-1)) && (cycles >= communication_fid_histogram_limit[bucket])) {
+		bucket++;
+	}
+	if(statistics->histogram[bucket] < UINT16_MAX) {
+		statistics->histogram[bucket]++;
+	}
+#endif
+
+	return ret;
 }
 
 
 BootloaderHandleMessageResponse set_contactor(const SetContactor *data) {
+	// Manual switching takes over from a running IO sequence
+	io_sequence_abort();
 	io.contactor = data->contactor_value;
 
 	return HANDLE_MESSAGE_RESPONSE_EMPTY;
@@ -174,7 +281,7 @@ BootloaderHandleMessageResponse get_rgb_value(const GetRGBValue *data, GetRGBVal
 }
 
 BootloaderHandleMessageResponse set_led_state(const SetLEDState *data) {
-	if((led.pattern > WARP_ENERGY_MANAGER_LED_PATTERN_BREATHING) || (led.hue > 359)) {
+	if((data->pattern > WARP_ENERGY_MANAGER_LED_PATTERN_SEQUENCE) || (data->hue > 359)) {
 		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
 	}
 
@@ -203,6 +310,162 @@ BootloaderHandleMessageResponse get_energy_meter_values(const GetEnergyMeterValu
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
+BootloaderHandleMessageResponse set_energy_log_configuration(const SetEnergyLogConfiguration *data) {
+	if(data->daily_energy_unit == 0) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	energy_log_set_configuration(data->enable, data->daily_energy_unit);
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse get_energy_log_configuration(const GetEnergyLogConfiguration *data, GetEnergyLogConfiguration_Response *response) {
+	response->header.length = sizeof(GetEnergyLogConfiguration_Response);
+	response->enable            = energy_log.enabled;
+	response->daily_energy_unit = energy_log.daily_unit_wh;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse set_energy_log_values(const SetEnergyLogValues *data) {
+	energy_log.flags = data->flags;
+	memcpy(energy_log.power_general, data->power_general, sizeof(energy_log.power_general));
+	energy_log.price = data->price;
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse set_energy_log_daily_values(const SetEnergyLogDailyValues *data) {
+	memcpy(energy_log.energy_general_in,  data->energy_general_in,  sizeof(energy_log.energy_general_in));
+	memcpy(energy_log.energy_general_out, data->energy_general_out, sizeof(energy_log.energy_general_out));
+	energy_log.daily_price = data->price;
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse get_energy_log_state(const GetEnergyLogState *data, GetEnergyLogState_Response *response) {
+	response->header.length       = sizeof(GetEnergyLogState_Response);
+	response->active              = energy_log.enabled && energy_log.slot_valid;
+	response->power_grid          = (energy_log.slot_covered_ms == 0) ? ENERGY_LOG_POWER_UNKNOWN : (int32_t)(energy_log.slot_energy / (int64_t)energy_log.slot_covered_ms);
+	response->slot_covered        = energy_log.slot_covered_ms;
+	response->energy_grid_in      = energy_log_get_daily_energy(energy_log.day_energy_in);
+	response->energy_grid_out     = energy_log_get_daily_energy(energy_log.day_energy_out);
+	response->data_points_written = energy_log.data_points_written;
+	response->data_points_dropped = energy_log.data_points_dropped;
+	response->data_points_pending = (energy_log.pending ? 1 : 0) + (energy_log.pending_daily ? 1 : 0);
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse start_io_sequence(const StartIOSequence *data, StartIOSequence_Response *response) {
+	if((data->length == 0) || (data->length > IO_SEQUENCE_STEP_NUM)) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	for(uint8_t i = 0; i < data->length; i++) {
+		if(data->command[i] >= IO_SEQUENCE_COMMAND_NUM) {
+			return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+		}
+
+		if(((data->command[i] == IO_SEQUENCE_COMMAND_SET_CONTACTOR) || (data->command[i] == IO_SEQUENCE_COMMAND_SET_OUTPUT)) && (data->argument[i] > 1)) {
+			return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+		}
+	}
+
+	response->header.length = sizeof(StartIOSequence_Response);
+	if(io_sequence_start(data->command, data->argument, data->length)) {
+		response->status = WARP_ENERGY_MANAGER_IO_SEQUENCE_STATUS_OK;
+	} else {
+		response->status = WARP_ENERGY_MANAGER_IO_SEQUENCE_STATUS_BUSY;
+	}
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse abort_io_sequence(const AbortIOSequence *data) {
+	io_sequence_abort();
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse get_io_sequence_state(const GetIOSequenceState *data, GetIOSequenceState_Response *response) {
+	response->header.length = sizeof(GetIOSequenceState_Response);
+	response->running       = io_sequence.running;
+	response->step          = io_sequence.step;
+	response->result        = io_sequence.result;
+	response->result_step   = io_sequence.result_step;
+	response->duration      = io_sequence.duration;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse set_led_sequence(const SetLEDSequence *data) {
+	if((data->length == 0) || (data->length > LED_KEYFRAME_NUM)) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	for(uint8_t i = 0; i < data->length; i++) {
+		led_set_sequence_keyframe(i, data->r[i], data->g[i], data->b[i], data->fade[i/8] & (1 << (i % 8)), data->duration[i]);
+	}
+	led.sequence.length = data->length;
+	led.sequence.repeat = data->repeat;
+
+	led.pattern = WARP_ENERGY_MANAGER_LED_PATTERN_SEQUENCE;
+	led.use_rgb = false;
+	led_restart_sequence();
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse get_led_sequence(const GetLEDSequence *data, GetLEDSequence_Response *response) {
+	response->header.length = sizeof(GetLEDSequence_Response);
+	response->length        = led.sequence.length;
+	response->repeat        = led.sequence.repeat;
+	memset(response->fade, 0, sizeof(response->fade));
+
+	for(uint8_t i = 0; i < LED_KEYFRAME_NUM; i++) {
+		const LEDKeyframe *keyframe = &led.sequence.keyframe[i];
+		response->r[i]        = keyframe->r;
+		response->g[i]        = keyframe->g;
+		response->b[i]        = keyframe->b;
+		response->fade[i/8]  |= keyframe->fade << (i % 8);
+		response->duration[i] = keyframe->frames*LED_FRAME_TIME;
+	}
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse set_voltage_monitor_configuration(const SetVoltageMonitorConfiguration *data) {
+	if(data->window < VOLTAGE_MONITOR_WINDOW_MIN) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	voltage_monitor_set_configuration(data->brown_out_threshold, data->window);
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse get_voltage_monitor_configuration(const GetVoltageMonitorConfiguration *data, GetVoltageMonitorConfiguration_Response *response) {
+	response->header.length       = sizeof(GetVoltageMonitorConfiguration_Response);
+	response->brown_out_threshold = voltage_monitor.brown_out_threshold;
+	response->window              = voltage_monitor.window;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_voltage_monitor_statistics(const GetVoltageMonitorStatistics *data, GetVoltageMonitorStatistics_Response *response) {
+	response->header.length   = sizeof(GetVoltageMonitorStatistics_Response);
+	response->valid           = voltage_monitor.valid;
+	response->min             = voltage_monitor.min;
+	response->max             = voltage_monitor.max;
+	response->avg             = voltage_monitor.avg;
+	response->brown_out       = voltage_monitor.brown_out;
+	response->brown_out_count = voltage_monitor.brown_out_count;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
 BootloaderHandleMessageResponse get_energy_meter_detailed_values_low_level(const GetEnergyMeterDetailedValuesLowLevel *data, GetEnergyMeterDetailedValuesLowLevel_Response *response) {
 	return meter_fill_communication_values((GenericMeterValues_Response*)response);
 }
@@ -247,6 +510,8 @@ BootloaderHandleMessageResponse get_input(const GetInput *data, GetInput_Respons
 }
 
 BootloaderHandleMessageResponse set_output(const SetOutput *data) {
+	// Manual switching takes over from a running IO sequence
+	io_sequence_abort();
 	io.output = data->output;
 
 	return HANDLE_MESSAGE_RESPONSE_EMPTY;
@@ -314,6 +579,134 @@ BootloaderHandleMessageResponse get_all_data_1(const GetAllData1 *data, GetAllDa
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
+// Last seen value and sequence number of the last change for each group of get_all_data_changes.
+// The comparison is done every loop in communication_tick, so a value that changes and changes
+// back between two polls is still reported as changed.
+static uint8_t all_data_changes_snapshot[ALL_DATA_CHANGES_DATA_SIZE];
+static uint32_t all_data_changes_group_sequence[ALL_DATA_CHANGES_GROUP_NUM];
+static uint32_t all_data_changes_sequence = 0;
+
+static uint8_t all_data_changes_fill_group(const uint8_t group, uint8_t *buffer) {
+	switch(group) {
+		case 0: {
+			buffer[0] = io.contactor;
+			return 1;
+		}
+
+		case 1: {
+			buffer[0] = led.r;
+			buffer[1] = led.g;
+			buffer[2] = led.b;
+			buffer[3] = led.pattern;
+			buffer[4] = led.hue & 0xFF;
+			buffer[5] = led.hue >> 8;
+			return 6;
+		}
+
+		case 2: {
+			const float values[4] = {
+				meter_register_set.PowerActiveLSumImExDiff.f,
+				meter_register_set.CurrentL1ImExSum.f,
+				meter_register_set.CurrentL2ImExSum.f,
+				meter_register_set.CurrentL3ImExSum.f
+			};
+			memcpy(buffer, values, sizeof(values));
+			return sizeof(values);
+		}
+
+		case 3: {
+			buffer[0] = (io.input[0] << 0) | (io.input[1] << 1);
+			return 1;
+		}
+
+		case 4: {
+			buffer[0] = io.output;
+			return 1;
+		}
+
+		case 5: {
+			buffer[0] = voltage.value & 0xFF;
+			buffer[1] = voltage.value >> 8;
+			return 2;
+		}
+
+		case 6: {
+			buffer[0] = io_get_contactor_check();
+			return 1;
+		}
+
+		case 7: {
+			for(uint8_t i = 0; i < SD_QUEUE_NUM; i++) {
+				buffer[i] = sd_queue_get_fill(i);
+			}
+			return SD_QUEUE_NUM;
+		}
+
+		case 8: {
+			buffer[0] = 0;
+			buffer[1] = 0;
+			buffer[2] = 0;
+			for(uint8_t page = 0; page < MIN(DATA_STORAGE_PAGES, 8); page++) {
+				buffer[0] |= data_storage.file_not_found[page]            << page;
+				buffer[1] |= data_storage.read_from_sd[page]              << page;
+				buffer[2] |= voltage_monitor_data_storage_is_pending(page) << page;
+			}
+			return 3;
+		}
+
+		default: return 0;
+	}
+}
+
+static void all_data_changes_tick(void) {
+	// Sequence 0 is never handed out, so a Brick that starts with 0 always resyncs
+	const bool first = (all_data_changes_sequence == 0);
+	if(first) {
+		all_data_changes_sequence = 1;
+	}
+
+	// All changes of one loop share the same new sequence number
+	bool sequence_incremented = false;
+	uint8_t pos = 0;
+	for(uint8_t group = 0; group < ALL_DATA_CHANGES_GROUP_NUM; group++) {
+		uint8_t buffer[16];
+		const uint8_t length = all_data_changes_fill_group(group, buffer);
+
+		if(first) {
+			all_data_changes_group_sequence[group] = 1;
+			memcpy(&all_data_changes_snapshot[pos], buffer, length);
+		} else if(memcmp(&all_data_changes_snapshot[pos], buffer, length) != 0) {
+			if(!sequence_incremented) {
+				all_data_changes_sequence++;
+				sequence_incremented = true;
+			}
+			all_data_changes_group_sequence[group] = all_data_changes_sequence;
+			memcpy(&all_data_changes_snapshot[pos], buffer, length);
+		}
+
+		pos += length;
+	}
+}
+
+BootloaderHandleMessageResponse get_all_data_changes(const GetAllDataChanges *data, GetAllDataChanges_Response *response) {
+	response->header.length = sizeof(GetAllDataChanges_Response);
+	response->sequence      = all_data_changes_sequence;
+
+	// Sequence 0 (first poll) or a sequence number from the future (we were restarted):
+	// The Brick has to take over all groups
+	response->resync        = (data->sequence == 0) || (data->sequence > all_data_changes_sequence);
+	response->changed       = 0;
+	for(uint8_t group = 0; group < ALL_DATA_CHANGES_GROUP_NUM; group++) {
+		if(response->resync || (all_data_changes_group_sequence[group] > data->sequence)) {
+			response->changed |= 1 << group;
+		}
+	}
+
+	memcpy(response->data, all_data_changes_snapshot, ALL_DATA_CHANGES_DATA_SIZE);
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
 BootloaderHandleMessageResponse get_sd_information(const GetSDInformation *data, GetSDInformation_Response *response) {
 	response->header.length   = sizeof(GetSDInformation_Response);
 	response->sd_status       = sd.sd_status;
@@ -341,13 +734,14 @@ BootloaderHandleMessageResponse set_sd_wallbox_data_point(const SetSDWallboxData
 
 	memcpy(&sd.wallbox_data_point[sd.wallbox_data_point_end], &data->wallbox_id, sizeof(SetSDWallboxDataPoint) - sizeof(TFPMessageHeader));
 	sd.wallbox_data_point_end++;
+	sd_queue_add(SD_QUEUE_WALLBOX, 1);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse get_sd_wallbox_data_points(const GetSDWallboxDataPoints *data, GetSDWallboxDataPoints_Response *response) {
 	response->header.length = sizeof(GetSDWallboxDataPoints_Response);
-	response->status        = get_sd_lfs_status(sd.new_sd_wallbox_data_points ? 1: 0, 1);
+	response->status        = get_sd_lfs_status((sd.new_sd_wallbox_data_points || sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_WALLBOX]) ? 1: 0, 1);
 	if(response->status != WARP_ENERGY_MANAGER_DATA_STATUS_OK) {
 		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 	}
@@ -379,13 +773,14 @@ BootloaderHandleMessageResponse set_sd_wallbox_daily_data_point(const SetSDWallb
 
 	memcpy(&sd.wallbox_daily_data_point[sd.wallbox_daily_data_point_end], &data->wallbox_id, sizeof(SetSDWallboxDailyDataPoint) - sizeof(TFPMessageHeader));
 	sd.wallbox_daily_data_point_end++;
+	sd_queue_add(SD_QUEUE_WALLBOX_DAILY, 1);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse get_sd_wallbox_daily_data_points(const GetSDWallboxDailyDataPoints *data, GetSDWallboxDailyDataPoints_Response *response) {
 	response->header.length = sizeof(GetSDWallboxDailyDataPoints_Response);
-	response->status        = get_sd_lfs_status(sd.new_sd_wallbox_daily_data_points ? 1: 0, 1);
+	response->status        = get_sd_lfs_status((sd.new_sd_wallbox_daily_data_points || sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_WALLBOX_DAILY]) ? 1: 0, 1);
 	if(response->status != WARP_ENERGY_MANAGER_DATA_STATUS_OK) {
 		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 	}
@@ -417,13 +812,14 @@ BootloaderHandleMessageResponse set_sd_energy_manager_data_point(const SetSDEner
 
 	memcpy(&sd.energy_manager_data_point[sd.energy_manager_data_point_end], &data->year, sizeof(SetSDEnergyManagerDataPoint) - sizeof(TFPMessageHeader));
 	sd.energy_manager_data_point_end++;
+	sd_queue_add(SD_QUEUE_ENERGY_MANAGER, 1);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse get_sd_energy_manager_data_points(const GetSDEnergyManagerDataPoints *data, GetSDEnergyManagerDataPoints_Response *response) {
 	response->header.length = sizeof(GetSDEnergyManagerDataPoints_Response);
-	response->status        = get_sd_lfs_status(sd.new_sd_energy_manager_data_points ? 1: 0, 1);
+	response->status        = get_sd_lfs_status((sd.new_sd_energy_manager_data_points || sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER]) ? 1: 0, 1);
 	if(response->status != WARP_ENERGY_MANAGER_DATA_STATUS_OK) {
 		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 	}
@@ -455,13 +851,14 @@ BootloaderHandleMessageResponse set_sd_energy_manager_daily_data_point(const Set
 
 	memcpy(&sd.energy_manager_daily_data_point[sd.energy_manager_daily_data_point_end], &data->year, sizeof(SetSDEnergyManagerDailyDataPoint) - sizeof(TFPMessageHeader));
 	sd.energy_manager_daily_data_point_end++;
+	sd_queue_add(SD_QUEUE_ENERGY_MANAGER_DAILY, 1);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse get_sd_energy_manager_daily_data_points(const GetSDEnergyManagerDailyDataPoints *data, GetSDEnergyManagerDailyDataPoints_Response *response) {
 	response->header.length = sizeof(GetSDEnergyManagerDailyDataPoints_Response);
-	response->status        = get_sd_lfs_status(sd.new_sd_energy_manager_daily_data_points ? 1: 0, 1);
+	response->status        = get_sd_lfs_status((sd.new_sd_energy_manager_daily_data_points || sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER_DAILY]) ? 1: 0, 1);
 	if(response->status != WARP_ENERGY_MANAGER_DATA_STATUS_OK) {
 		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 	}
@@ -547,13 +944,12 @@ BootloaderHandleMessageResponse set_data_storage(const SetDataStorage *data) {
 	}
 
 	// Copy data into storage and set new change time.
-	// Data will be copied from RAM to SD after 10 minutes.
+	// Data will be copied from RAM to SD after 10 minutes, with active
+	// brown-out detection the voltage monitor holds it back for longer.
 	if(!data_storage.has_been_written_once[data->page] || memcmp(data_storage.storage[data->page], data->data, 63) != 0) {
 		data_storage.file_not_found[data->page] = false;
 		memcpy(data_storage.storage[data->page], data->data, 63);
-		if(data_storage.last_change_time[data->page] == 0) {
-			data_storage.last_change_time[data->page] = system_timer_get_ms();
-		}
+		voltage_monitor_data_storage_changed(data->page);
 	}
 
 	return HANDLE_MESSAGE_RESPONSE_EMPTY;
@@ -567,10 +963,208 @@ BootloaderHandleMessageResponse reset_energy_meter_relative_energy(const ResetEn
 	return HANDLE_MESSAGE_RESPONSE_EMPTY;
 }
 
+BootloaderHandleMessageResponse get_tick_statistics(const GetTickStatistics *data, GetTickStatistics_Response *response) {
+	if(data->tick >= PROFILER_TICK_NUM) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	const ProfilerStatisticsUs statistics = profiler_get_statistics_us(&profiler.tick[data->tick]);
+
+	response->header.length = sizeof(GetTickStatistics_Response);
+	response->count         = statistics.count;
+	response->min           = statistics.min;
+	response->avg           = statistics.avg;
+	response->max           = statistics.max;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_loop_statistics(const GetLoopStatistics *data, GetLoopStatistics_Response *response) {
+	const ProfilerStatisticsUs statistics = profiler_get_statistics_us(&profiler.loop);
+
+	response->header.length = sizeof(GetLoopStatistics_Response);
+	response->count         = statistics.count;
+	response->min           = statistics.min;
+	response->avg           = statistics.avg;
+	response->max           = statistics.max;
+	memcpy(response->histogram, profiler.histogram, sizeof(response->histogram));
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse reset_tick_statistics(const ResetTickStatistics *data) {
+	profiler_reset();
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse set_sd_wallbox_data_points(const SetSDWallboxDataPoints *data, SetSDWallboxDataPoints_Response *response) {
+	response->header.length = sizeof(SetSDWallboxDataPoints_Response);
+	response->accepted      = 0;
+	if((data->data_length == 0) || (data->data_length > SET_SD_WALLBOX_DATA_POINTS_MAX)) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	// Same order as set_sd_wallbox_data_point: SD/LFS errors take precedence over a bad date
+	response->status        = get_sd_lfs_status(sd.wallbox_data_point_end, SD_WALLBOX_DATA_POINT_LENGTH);
+	if(response->status != WARP_ENERGY_MANAGER_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+	response->status        = get_date_status(data->year, data->month, data->day, data->hour, data->minute);
+	if(response->status != WARP_ENERGY_MANAGER_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+
+	// A wallbox can only have one data point per timestamp. Duplicates of an entry
+	// that is still queued or of an earlier entry of this batch are rejected.
+	uint8_t accepted = 0;
+	uint8_t count    = 0;
+	for(uint8_t i = 0; i < data->data_length; i++) {
+		bool duplicate = false;
+		for(uint8_t j = 0; j < i; j++) {
+			if((accepted & (1 << j)) && (data->wallbox_id[j] == data->wallbox_id[i])) {
+				duplicate = true;
+				break;
+			}
+		}
+
+		for(uint8_t j = 0; !duplicate && (j < sd.wallbox_data_point_end); j++) {
+			const WallboxDataPoint *queued = &sd.wallbox_data_point[j];
+			duplicate = (queued->wallbox_id == data->wallbox_id[i]) &&
+			            (queued->year       == data->year)          &&
+			            (queued->month      == data->month)         &&
+			            (queued->day        == data->day)           &&
+			            (queued->hour       == data->hour)          &&
+			            (queued->minute     == data->minute);
+		}
+
+		if(!duplicate) {
+			accepted |= 1 << i;
+			count++;
+		}
+	}
+
+	// Everything was a duplicate of a queued entry, there is nothing to add
+	if(count == 0) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+
+	// All-or-nothing: Either every accepted entry fits in the queue or none is added.
+	// The sd task only runs between messages, so it can't see a partially filled batch.
+	response->status        = get_sd_lfs_status(sd.wallbox_data_point_end + count - 1, SD_WALLBOX_DATA_POINT_LENGTH);
+	if(response->status != WARP_ENERGY_MANAGER_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+
+	// Same layout as the payload of SetSDWallboxDataPoint
+	SetSDWallboxDataPoint point;
+	point.year   = data->year;
+	point.month  = data->month;
+	point.day    = data->day;
+	point.hour   = data->hour;
+	point.minute = data->minute;
+
+	for(uint8_t i = 0; i < data->data_length; i++) {
+		if(accepted & (1 << i)) {
+			point.wallbox_id = data->wallbox_id[i];
+			point.flags      = data->flags[i];
+			point.power      = data->power[i];
+
+			memcpy(&sd.wallbox_data_point[sd.wallbox_data_point_end], &point.wallbox_id, sizeof(SetSDWallboxDataPoint) - sizeof(TFPMessageHeader));
+			sd.wallbox_data_point_end++;
+		}
+	}
+
+	sd_queue_add(SD_QUEUE_WALLBOX, count);
+
+	response->accepted      = accepted;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_sd_queue_status(const GetSDQueueStatus *data, GetSDQueueStatus_Response *response) {
+	response->header.length = sizeof(GetSDQueueStatus_Response);
+	for(uint8_t i = 0; i < SD_QUEUE_NUM; i++) {
+		response->fill[i]                = sd_queue_get_fill(i);
+		response->capacity[i]            = sd_queue_get_capacity(i);
+		response->oldest_age[i]          = sd_queue_get_oldest_age(i);
+		response->last_flush_duration[i] = sd_queue.queue[i].last_flush_duration;
+	}
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse cancel_sd_data_points(const CancelSDDataPoints *data) {
+	if(data->data_points_type > WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER_DAILY) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	sd_data_points_cancel[data->data_points_type] = true;
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+// Drops the next chunk of a cancelled stream instead of sending it.
+// Returns false as soon as the last chunk of the stream is dropped or if no stream is running anymore.
+static bool sd_drop_cancelled_chunk(bool *is_buffered, const bool buffered_is_last, bool *new_cb, const bool new_is_last, const bool query_running) {
+	if(*is_buffered) {
+		*is_buffered = false;
+		return !buffered_is_last;
+	}
+
+	if(*new_cb) {
+		*new_cb = false;
+		return !new_is_last;
+	}
+
+	return query_running;
+}
+
+BootloaderHandleMessageResponse get_fid_statistics(const GetFIDStatistics *data, GetFIDStatistics_Response *response) {
+	if(data->fid >= COMMUNICATION_FID_NUM) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	response->header.length = sizeof(GetFIDStatistics_Response);
+#ifdef COMMUNICATION_FID_STATISTICS
+	const CommunicationFIDStatistics *statistics = &communication_fid_statistics[data->fid];
+	response->calls          = statistics->calls;
+	response->invalid_length = statistics->invalid_length;
+	response->max            = profiler_cycles_to_us(statistics->max_cycles);
+	memcpy(response->histogram, statistics->histogram, sizeof(statistics->histogram));
+#else
+	response->calls          = 0;
+	response->invalid_length = 0;
+	response->max            = 0;
+	memset(response->histogram, 0, sizeof(response->histogram));
+#endif
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse reset_fid_statistics(const ResetFIDStatistics *data) {
+#ifdef COMMUNICATION_FID_STATISTICS
+	memset(communication_fid_statistics, 0, sizeof(communication_fid_statistics));
+#endif
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
 bool handle_sd_wallbox_data_points_low_level_callback(void) {
 	static bool is_buffered = false;
 	static SDWallboxDataPointsLowLevel_Callback cb;
 
+	if(sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_WALLBOX]) {
+		sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_WALLBOX] = sd_drop_cancelled_chunk(
+			&is_buffered,
+			cb.data_chunk_offset + SD_CB_CHUNK_LENGTH(cb) >= cb.data_length,
+			&sd.new_sd_wallbox_data_points_cb,
+			sd.sd_wallbox_data_points_cb_offset + SD_CB_CHUNK_LENGTH(cb) >= sd.sd_wallbox_data_points_cb_data_length,
+			sd.new_sd_wallbox_data_points
+		);
+		return false;
+	}
+
 	if(!is_buffered) {
 		if(!sd.new_sd_wallbox_data_points_cb) {
 			return false;
@@ -599,6 +1193,17 @@ bool handle_sd_wallbox_daily_data_points_low_level_callback(void) {
 	static bool is_buffered = false;
 	static SDWallboxDailyDataPointsLowLevel_Callback cb;
 
+	if(sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_WALLBOX_DAILY]) {
+		sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_WALLBOX_DAILY] = sd_drop_cancelled_chunk(
+			&is_buffered,
+			cb.data_chunk_offset + SD_CB_CHUNK_LENGTH(cb) >= cb.data_length,
+			&sd.new_sd_wallbox_daily_data_points_cb,
+			sd.sd_wallbox_daily_data_points_cb_offset + SD_CB_CHUNK_LENGTH(cb) >= sd.sd_wallbox_daily_data_points_cb_data_length,
+			sd.new_sd_wallbox_daily_data_points
+		);
+		return false;
+	}
+
 	if(!is_buffered) {
 		if(!sd.new_sd_wallbox_daily_data_points_cb) {
 			return false;
@@ -627,6 +1232,17 @@ bool handle_sd_energy_manager_data_points_low_level_callback(void) {
 	static bool is_buffered = false;
 	static SDEnergyManagerDataPointsLowLevel_Callback cb;
 
+	if(sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER]) {
+		sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER] = sd_drop_cancelled_chunk(
+			&is_buffered,
+			cb.data_chunk_offset + SD_CB_CHUNK_LENGTH(cb) >= cb.data_length,
+			&sd.new_sd_energy_manager_data_points_cb,
+			sd.sd_energy_manager_data_points_cb_offset + SD_CB_CHUNK_LENGTH(cb) >= sd.sd_energy_manager_data_points_cb_data_length,
+			sd.new_sd_energy_manager_data_points
+		);
+		return false;
+	}
+
 	if(!is_buffered) {
 		if(!sd.new_sd_energy_manager_data_points_cb) {
 			return false;
@@ -655,6 +1271,17 @@ bool handle_sd_energy_manager_daily_data_points_low_level_callback(void) {
 	static bool is_buffered = false;
 	static SDEnergyManagerDailyDataPointsLowLevel_Callback cb;
 
+	if(sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER_DAILY]) {
+		sd_data_points_cancel[WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER_DAILY] = sd_drop_cancelled_chunk(
+			&is_buffered,
+			cb.data_chunk_offset + SD_CB_CHUNK_LENGTH(cb) >= cb.data_length,
+			&sd.new_sd_energy_manager_daily_data_points_cb,
+			sd.sd_energy_manager_daily_data_points_cb_offset + SD_CB_CHUNK_LENGTH(cb) >= sd.sd_energy_manager_daily_data_points_cb_data_length,
+			sd.new_sd_energy_manager_daily_data_points
+		);
+		return false;
+	}
+
 	if(!is_buffered) {
 		if(!sd.new_sd_energy_manager_daily_data_points_cb) {
 			return false;
@@ -679,10 +1306,45 @@ bool handle_sd_energy_manager_daily_data_points_low_level_callback(void) {
 	return false;
 }
 
+bool handle_io_sequence_done_callback(void) {
+	static bool is_buffered = false;
+	static IOSequenceDone_Callback cb;
+
+	if(!is_buffered) {
+		if(!io_sequence.done) {
+			return false;
+		}
+
+		tfp_make_default_header(&cb.header, bootloader_get_uid(), sizeof(IOSequenceDone_Callback), FID_CALLBACK_IO_SEQUENCE_DONE);
+		cb.result        = io_sequence.result;
+		cb.step          = io_sequence.result_step;
+		cb.duration      = io_sequence.duration;
+		io_sequence.done = false;
+	}
+
+	if(bootloader_spitfp_is_send_possible(&bootloader_status.st)) {
+		bootloader_spitfp_send_ack_and_message(&bootloader_status, (uint8_t*)&cb, sizeof(IOSequenceDone_Callback));
+		is_buffered = false;
+		return true;
+	} else {
+		is_buffered = true;
+	}
+
+	return false;
+}
+
 void communication_tick(void) {
+	all_data_changes_tick();
 	communication_callback_tick();
 }
 
 void communication_init(void) {
 	communication_callback_init();
+
+#ifdef COMMUNICATION_FID_STATISTICS
+	memset(communication_fid_statistics, 0, sizeof(communication_fid_statistics));
+	for(uint8_t i = 0; i < (COMMUNICATION_FID_HISTOGRAM_BUCKETS-1); i++) {
+		communication_fid_histogram_limit[i] = (COMMUNICATION_FID_HISTOGRAM_BASE_US << (i*COMMUNICATION_FID_HISTOGRAM_SHIFT)) * profiler.cycles_per_us;
+	}
+#endif
 }
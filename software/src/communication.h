@@ -28,6 +28,8 @@
 #include "bricklib2/protocols/tfp/tfp.h"
 #include "bricklib2/bootloader/bootloader.h"
 
+#include "io_sequence.h"
+
 // Default functions
 BootloaderHandleMessageResponse handle_message(const void *data, void *response);
 void communication_tick(void);
@@ -61,11 +63,59 @@ void communication_init(void);
 #define WARP_ENERGY_MANAGER_LED_PATTERN_ON 1
 #define WARP_ENERGY_MANAGER_LED_PATTERN_BLINKING 2
 #define WARP_ENERGY_MANAGER_LED_PATTERN_BREATHING 3
+#define WARP_ENERGY_MANAGER_LED_PATTERN_SEQUENCE 4
 
 #define WARP_ENERGY_MANAGER_DATA_STORAGE_STATUS_OK 0
 #define WARP_ENERGY_MANAGER_DATA_STORAGE_STATUS_NOT_FOUND 1
 #define WARP_ENERGY_MANAGER_DATA_STORAGE_STATUS_BUSY 2
 
+#define WARP_ENERGY_MANAGER_TICK_BOOTLOADER 0
+#define WARP_ENERGY_MANAGER_TICK_COMMUNICATION 1
+#define WARP_ENERGY_MANAGER_TICK_IO 2
+#define WARP_ENERGY_MANAGER_TICK_LED 3
+#define WARP_ENERGY_MANAGER_TICK_RS485 4
+#define WARP_ENERGY_MANAGER_TICK_METER 5
+#define WARP_ENERGY_MANAGER_TICK_VOLTAGE 6
+#define WARP_ENERGY_MANAGER_TICK_DATE_TIME 7
+#define WARP_ENERGY_MANAGER_TICK_SD 8
+#define WARP_ENERGY_MANAGER_TICK_DATA_STORAGE 9
+#define WARP_ENERGY_MANAGER_TICK_SD_QUEUE 10
+#define WARP_ENERGY_MANAGER_TICK_ENERGY_LOG 11
+#define WARP_ENERGY_MANAGER_TICK_VOLTAGE_MONITOR 12
+
+#define WARP_ENERGY_MANAGER_SD_QUEUE_WALLBOX 0
+#define WARP_ENERGY_MANAGER_SD_QUEUE_WALLBOX_DAILY 1
+#define WARP_ENERGY_MANAGER_SD_QUEUE_ENERGY_MANAGER 2
+#define WARP_ENERGY_MANAGER_SD_QUEUE_ENERGY_MANAGER_DAILY 3
+
+#define WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_WALLBOX 0
+#define WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_WALLBOX_DAILY 1
+#define WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER 2
+#define WARP_ENERGY_MANAGER_DATA_POINTS_TYPE_ENERGY_MANAGER_DAILY 3
+
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_COMMAND_SET_CONTACTOR 0
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_COMMAND_SET_OUTPUT 1
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_COMMAND_WAIT 2
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_COMMAND_VERIFY_CONTACTOR 3
+
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_STATUS_OK 0
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_STATUS_BUSY 1
+
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_RESULT_OK 0
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_RESULT_CONTACTOR_CHECK_FAILED 1
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_RESULT_TIMEOUT 2
+#define WARP_ENERGY_MANAGER_IO_SEQUENCE_RESULT_ABORTED 3
+
+#define WARP_ENERGY_MANAGER_ALL_DATA_CONTACTOR (1 << 0)
+#define WARP_ENERGY_MANAGER_ALL_DATA_LED (1 << 1)
+#define WARP_ENERGY_MANAGER_ALL_DATA_ENERGY_METER_VALUES (1 << 2)
+#define WARP_ENERGY_MANAGER_ALL_DATA_INPUT (1 << 3)
+#define WARP_ENERGY_MANAGER_ALL_DATA_OUTPUT (1 << 4)
+#define WARP_ENERGY_MANAGER_ALL_DATA_INPUT_VOLTAGE (1 << 5)
+#define WARP_ENERGY_MANAGER_ALL_DATA_CONTACTOR_CHECK (1 << 6)
+#define WARP_ENERGY_MANAGER_ALL_DATA_SD_QUEUE (1 << 7)
+#define WARP_ENERGY_MANAGER_ALL_DATA_DATA_STORAGE (1 << 8)
+
 #define WARP_ENERGY_MANAGER_BOOTLOADER_MODE_BOOTLOADER 0
 #define WARP_ENERGY_MANAGER_BOOTLOADER_MODE_FIRMWARE 1
 #define WARP_ENERGY_MANAGER_BOOTLOADER_MODE_BOOTLOADER_WAIT_FOR_REBOOT 2
@@ -116,11 +166,44 @@ void communication_init(void);
 #define FID_GET_DATA_STORAGE 33
 #define FID_SET_DATA_STORAGE 34
 #define FID_RESET_ENERGY_METER_RELATIVE_ENERGY 35
+#define FID_GET_TICK_STATISTICS 36
+#define FID_GET_LOOP_STATISTICS 37
+#define FID_RESET_TICK_STATISTICS 38
+#define FID_SET_SD_WALLBOX_DATA_POINTS 39
+#define FID_GET_SD_QUEUE_STATUS 40
+#define FID_CANCEL_SD_DATA_POINTS 41
+#define FID_GET_FID_STATISTICS 42
+#define FID_GET_ALL_DATA_CHANGES 43
+#define FID_SET_ENERGY_LOG_CONFIGURATION 44
+#define FID_GET_ENERGY_LOG_CONFIGURATION 45
+#define FID_SET_ENERGY_LOG_VALUES 46
+#define FID_SET_ENERGY_LOG_DAILY_VALUES 47
+#define FID_GET_ENERGY_LOG_STATE 48
+#define FID_START_IO_SEQUENCE 49
+#define FID_ABORT_IO_SEQUENCE 50
+#define FID_GET_IO_SEQUENCE_STATE 51
+#define FID_SET_LED_SEQUENCE 53
+#define FID_GET_LED_SEQUENCE 54
+
+#define FID_SET_VOLTAGE_MONITOR_CONFIGURATION 55
+#define FID_GET_VOLTAGE_MONITOR_CONFIGURATION 56
+#define FID_GET_VOLTAGE_MONITOR_STATISTICS 57
+#define FID_RESET_FID_STATISTICS 58
+
+#define COMMUNICATION_FID_NUM 59
+
+// Handler duration histogram: Bucket i counts calls that took less than
+// COMMUNICATION_FID_HISTOGRAM_BASE_US << (i*COMMUNICATION_FID_HISTOGRAM_SHIFT),
+// the last bucket counts everything above (10us, 80us, 640us, more).
+#define COMMUNICATION_FID_HISTOGRAM_BUCKETS 4
+#define COMMUNICATION_FID_HISTOGRAM_BASE_US 10
+#define COMMUNICATION_FID_HISTOGRAM_SHIFT   3
 
 #define FID_CALLBACK_SD_WALLBOX_DATA_POINTS_LOW_LEVEL 24
 #define FID_CALLBACK_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL 25
 #define FID_CALLBACK_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL 26
 #define FID_CALLBACK_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL 27
+#define FID_CALLBACK_IO_SEQUENCE_DONE 52
 
 typedef struct {
 	TFPMessageHeader header;
@@ -497,6 +580,263 @@ typedef struct {
 	TFPMessageHeader header;
 } __attribute__((__packed__)) ResetEnergyMeterRelativeEnergy;
 
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t tick;
+} __attribute__((__packed__)) GetTickStatistics;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint32_t count;
+	uint32_t min;
+	uint32_t avg;
+	uint32_t max;
+} __attribute__((__packed__)) GetTickStatistics_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetLoopStatistics;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint32_t count;
+	uint32_t min;
+	uint32_t avg;
+	uint32_t max;
+	uint32_t histogram[12];
+} __attribute__((__packed__)) GetLoopStatistics_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) ResetTickStatistics;
+
+// 6 + 8*7 = 62 bytes fit into the 64 byte TFP payload and the accepted
+// bitmask has exactly one bit per data point
+#define SET_SD_WALLBOX_DATA_POINTS_MAX 8
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t year;
+	uint8_t month;
+	uint8_t day;
+	uint8_t hour;
+	uint8_t minute;
+	uint8_t data_length;
+	uint32_t wallbox_id[SET_SD_WALLBOX_DATA_POINTS_MAX];
+	uint8_t flags[SET_SD_WALLBOX_DATA_POINTS_MAX];
+	uint16_t power[SET_SD_WALLBOX_DATA_POINTS_MAX];
+} __attribute__((__packed__)) SetSDWallboxDataPoints;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint8_t accepted;
+} __attribute__((__packed__)) SetSDWallboxDataPoints_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetSDQueueStatus;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t fill[4];
+	uint8_t capacity[4];
+	uint32_t oldest_age[4];
+	uint32_t last_flush_duration[4];
+} __attribute__((__packed__)) GetSDQueueStatus_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t data_points_type;
+} __attribute__((__packed__)) CancelSDDataPoints;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t fid;
+} __attribute__((__packed__)) GetFIDStatistics;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint32_t calls;
+	uint32_t invalid_length;
+	uint32_t max;
+	uint16_t histogram[COMMUNICATION_FID_HISTOGRAM_BUCKETS];
+} __attribute__((__packed__)) GetFIDStatistics_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) ResetFIDStatistics;
+
+// Groups in order of the WARP_ENERGY_MANAGER_ALL_DATA_* bits, with their payload in byte:
+// contactor_value (1), r, g, b, pattern, hue (6), power, current[3] (16), input (1),
+// output (1), voltage (2), contactor_check_state (1), sd queue fill[4] (4),
+// data storage not_found, busy, pending bitmasks (3)
+#define ALL_DATA_CHANGES_GROUP_NUM 9
+#define ALL_DATA_CHANGES_DATA_SIZE 35
+
+typedef struct {
+	TFPMessageHeader header;
+	uint32_t sequence;
+} __attribute__((__packed__)) GetAllDataChanges;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint32_t sequence;
+	uint16_t changed;                         // Groups that changed since the requested sequence
+	bool resync;                              // Unknown sequence, all groups are marked as changed
+	uint8_t data[ALL_DATA_CHANGES_DATA_SIZE]; // All groups, changed or not
+} __attribute__((__packed__)) GetAllDataChanges_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	bool enable;
+	uint16_t daily_energy_unit; // Wh
+} __attribute__((__packed__)) SetEnergyLogConfiguration;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetEnergyLogConfiguration;
+
+typedef struct {
+	TFPMessageHeader header;
+	bool enable;
+	uint16_t daily_energy_unit; // Wh
+} __attribute__((__packed__)) GetEnergyLogConfiguration_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t flags;
+	int32_t power_general[6];
+	uint32_t price;
+} __attribute__((__packed__)) SetEnergyLogValues;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint32_t energy_general_in[6];
+	uint32_t energy_general_out[6];
+	uint32_t price;
+} __attribute__((__packed__)) SetEnergyLogDailyValues;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetEnergyLogState;
+
+typedef struct {
+	TFPMessageHeader header;
+	bool active;
+	int32_t power_grid;
+	uint32_t slot_covered;
+	uint32_t energy_grid_in;
+	uint32_t energy_grid_out;
+	uint32_t data_points_written;
+	uint32_t data_points_dropped;
+	uint8_t data_points_pending;
+} __attribute__((__packed__)) GetEnergyLogState_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t length;
+	uint8_t command[IO_SEQUENCE_STEP_NUM];
+	uint16_t argument[IO_SEQUENCE_STEP_NUM];
+} __attribute__((__packed__)) StartIOSequence;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+} __attribute__((__packed__)) StartIOSequence_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) AbortIOSequence;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetIOSequenceState;
+
+typedef struct {
+	TFPMessageHeader header;
+	bool running;
+	uint8_t step;
+	uint8_t result;
+	uint8_t result_step;
+	uint32_t duration;
+} __attribute__((__packed__)) GetIOSequenceState_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t length;
+	uint8_t repeat;
+	uint8_t r[10];
+	uint8_t g[10];
+	uint8_t b[10];
+	uint8_t fade[2];
+	uint16_t duration[10];
+} __attribute__((__packed__)) SetLEDSequence;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetLEDSequence;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t length;
+	uint8_t repeat;
+	uint8_t r[10];
+	uint8_t g[10];
+	uint8_t b[10];
+	uint8_t fade[2];
+	uint16_t duration[10];
+} __attribute__((__packed__)) GetLEDSequence_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t brown_out_threshold;
+	uint16_t window;
+} __attribute__((__packed__)) SetVoltageMonitorConfiguration;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetVoltageMonitorConfiguration;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t brown_out_threshold;
+	uint16_t window;
+} __attribute__((__packed__)) GetVoltageMonitorConfiguration_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetVoltageMonitorStatistics;
+
+typedef struct {
+	TFPMessageHeader header;
+	bool valid;
+	uint16_t min;
+	uint16_t max;
+	uint16_t avg;
+	bool brown_out;
+	uint32_t brown_out_count;
+} __attribute__((__packed__)) GetVoltageMonitorStatistics_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t result;
+	uint8_t step;
+	uint32_t duration;
+} __attribute__((__packed__)) IOSequenceDone_Callback;
+
+
+typedef struct {
+	uint8_t length;                  // Expected message length, 0 = FID not supported
+	BootloaderHandleMessageResponse (*handler)(const void *message, void *response);
+} CommunicationFunction;
+
+typedef struct {
+	uint32_t calls;
+	uint32_t invalid_length;
+	uint32_t max_cycles;
+	uint16_t histogram[COMMUNICATION_FID_HISTOGRAM_BUCKETS]; // Saturates at 65535
+} CommunicationFIDStatistics;
 
 // Function prototypes
 BootloaderHandleMessageResponse set_contactor(const SetContactor *data);
@@ -530,20 +870,44 @@ BootloaderHandleMessageResponse get_led_state(const GetLEDState *data, GetLEDSta
 BootloaderHandleMessageResponse get_data_storage(const GetDataStorage *data, GetDataStorage_Response *response);
 BootloaderHandleMessageResponse set_data_storage(const SetDataStorage *data);
 BootloaderHandleMessageResponse reset_energy_meter_relative_energy(const ResetEnergyMeterRelativeEnergy *data);
+BootloaderHandleMessageResponse get_tick_statistics(const GetTickStatistics *data, GetTickStatistics_Response *response);
+BootloaderHandleMessageResponse get_loop_statistics(const GetLoopStatistics *data, GetLoopStatistics_Response *response);
+BootloaderHandleMessageResponse reset_tick_statistics(const ResetTickStatistics *data);
+BootloaderHandleMessageResponse set_sd_wallbox_data_points(const SetSDWallboxDataPoints *data, SetSDWallboxDataPoints_Response *response);
+BootloaderHandleMessageResponse get_sd_queue_status(const GetSDQueueStatus *data, GetSDQueueStatus_Response *response);
+BootloaderHandleMessageResponse cancel_sd_data_points(const CancelSDDataPoints *data);
+BootloaderHandleMessageResponse get_fid_statistics(const GetFIDStatistics *data, GetFIDStatistics_Response *response);
+BootloaderHandleMessageResponse get_all_data_changes(const GetAllDataChanges *data, GetAllDataChanges_Response *response);
+BootloaderHandleMessageResponse set_energy_log_configuration(const SetEnergyLogConfiguration *data);
+BootloaderHandleMessageResponse get_energy_log_configuration(const GetEnergyLogConfiguration *data, GetEnergyLogConfiguration_Response *response);
+BootloaderHandleMessageResponse set_energy_log_values(const SetEnergyLogValues *data);
+BootloaderHandleMessageResponse set_energy_log_daily_values(const SetEnergyLogDailyValues *data);
+BootloaderHandleMessageResponse get_energy_log_state(const GetEnergyLogState *data, GetEnergyLogState_Response *response);
+BootloaderHandleMessageResponse start_io_sequence(const StartIOSequence *data, StartIOSequence_Response *response);
+BootloaderHandleMessageResponse abort_io_sequence(const AbortIOSequence *data);
+BootloaderHandleMessageResponse get_io_sequence_state(const GetIOSequenceState *data, GetIOSequenceState_Response *response);
+BootloaderHandleMessageResponse set_led_sequence(const SetLEDSequence *data);
+BootloaderHandleMessageResponse get_led_sequence(const GetLEDSequence *data, GetLEDSequence_Response *response);
+BootloaderHandleMessageResponse set_voltage_monitor_configuration(const SetVoltageMonitorConfiguration *data);
+BootloaderHandleMessageResponse get_voltage_monitor_configuration(const GetVoltageMonitorConfiguration *data, GetVoltageMonitorConfiguration_Response *response);
+BootloaderHandleMessageResponse get_voltage_monitor_statistics(const GetVoltageMonitorStatistics *data, GetVoltageMonitorStatistics_Response *response);
+BootloaderHandleMessageResponse reset_fid_statistics(const ResetFIDStatistics *data);
 
 // Callbacks
 bool handle_sd_wallbox_data_points_low_level_callback(void);
 bool handle_sd_wallbox_daily_data_points_low_level_callback(void);
 bool handle_sd_energy_manager_data_points_low_level_callback(void);
 bool handle_sd_energy_manager_daily_data_points_low_level_callback(void);
+bool handle_io_sequence_done_callback(void);
 
 #define COMMUNICATION_CALLBACK_TICK_WAIT_MS 1
-#define COMMUNICATION_CALLBACK_HANDLER_NUM 4
+#define COMMUNICATION_CALLBACK_HANDLER_NUM 5
 #define COMMUNICATION_CALLBACK_LIST_INIT \
 	handle_sd_wallbox_data_points_low_level_callback, \
 	handle_sd_wallbox_daily_data_points_low_level_callback, \
 	handle_sd_energy_manager_data_points_low_level_callback, \
 	handle_sd_energy_manager_daily_data_points_low_level_callback, \
+	handle_io_sequence_done_callback, \
 
 
 #endif
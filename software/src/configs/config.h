@@ -41,4 +41,6 @@
 #define IS_ENERGY_MANAGER
 #define IS_ENERGY_MANAGER_V1
 
+//#define COMMUNICATION_FID_STATISTICS // Per FID call counters and handler durations (about 900 byte RAM), see get_fid_statistics
+
 #endif
@@ -33,4 +33,6 @@
 #define LED_B_PIN               P1_4
 #define LED_B_CCU4_SLICE        0
 
+#define LED_FRAME_TIME          10 // in ms, step of the uploaded LED sequences
+
 #endif
\ No newline at end of file
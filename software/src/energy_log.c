@@ -0,0 +1,284 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * energy_log.c: Autonomous 5 minute and daily energy manager data points
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "energy_log.h"
+
+#include <string.h>
+#include <math.h>
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+#include "bricklib2/bootloader/bootloader.h"
+#include "bricklib2/warp/meter.h"
+#include "bricklib2/warp/rs485.h"
+#include "xmc_rtc.h"
+
+// Without the energy log the Brick computes every 5 minute and daily data
+// point and sends it with set_sd_energy_manager_(daily_)data_point. While
+// the Brick reboots these data points are lost. With the energy log enabled
+// we integrate the grid power ourselves and queue the data points when the
+// RTC enters the next slot. The Brick only provides the values we can't know
+// (flags, general meters and price) whenever they change.
+
+EnergyLog energy_log;
+
+static bool energy_log_get_slot(EnergyLogSlot *slot) {
+	XMC_RTC_TIME_t rtc_time;
+	XMC_RTC_GetTime(&rtc_time);
+	if(rtc_time.year < ENERGY_LOG_MIN_YEAR) {
+		return false;
+	}
+
+	// Day and month of the RTC start at 0
+	slot->year   = (uint8_t)(rtc_time.year - 2000);
+	slot->month  = rtc_time.month + 1;
+	slot->day    = rtc_time.days + 1;
+	slot->hour   = rtc_time.hours;
+	slot->minute = rtc_time.minutes - (rtc_time.minutes % 5);
+
+	return true;
+}
+
+static void energy_log_reset_slot(void) {
+	energy_log.slot_energy     = 0;
+	energy_log.slot_covered_ms = 0;
+}
+
+static void energy_log_reset_day(void) {
+	energy_log.day_energy_in  = 0;
+	energy_log.day_energy_out = 0;
+	energy_log.day_covered    = false;
+}
+
+static void energy_log_handle_status(const uint8_t status, bool *pending) {
+	switch(status) {
+		case WARP_ENERGY_MANAGER_DATA_STATUS_OK:                energy_log.data_points_written++; break;
+		case WARP_ENERGY_MANAGER_DATA_STATUS_DATE_OUT_OF_RANGE: energy_log.data_points_dropped++; break;
+
+		// Queue full or SD card not ready (yet), try again with the next check
+		default: return;
+	}
+
+	*pending = false;
+}
+
+static void energy_log_queue(void) {
+	// Same checks and queue as for the data points of the Brick
+	if(energy_log.pending) {
+		SetSDEnergyManagerDataPoint_Response response;
+		set_sd_energy_manager_data_point(&energy_log.data_point, &response);
+		energy_log_handle_status(response.status, &energy_log.pending);
+	}
+
+	if(energy_log.pending_daily) {
+		SetSDEnergyManagerDailyDataPoint_Response response;
+		set_sd_energy_manager_daily_data_point(&energy_log.daily_data_point, &response);
+		energy_log_handle_status(response.status, &energy_log.pending_daily);
+	}
+}
+
+static void energy_log_finish_slot(const EnergyLogSlot *next) {
+	const EnergyLogSlot *slot = &energy_log.slot;
+
+	if(energy_log.slot_covered_ms > 0) {
+		// A data point that could not be queued for 5 minutes is replaced
+		if(energy_log.pending) {
+			energy_log.data_points_dropped++;
+		}
+
+		SetSDEnergyManagerDataPoint *dp = &energy_log.data_point;
+		dp->year       = slot->year;
+		dp->month      = slot->month;
+		dp->day        = slot->day;
+		dp->hour       = slot->hour;
+		dp->minute     = slot->minute;
+		dp->flags      = energy_log.flags;
+		dp->power_grid = (int32_t)(energy_log.slot_energy / (int64_t)energy_log.slot_covered_ms);
+		memcpy(dp->power_general, energy_log.power_general, sizeof(dp->power_general));
+		dp->price      = energy_log.price;
+		energy_log.pending = true;
+	}
+	energy_log_reset_slot();
+
+	if((next->year == slot->year) && (next->month == slot->month) && (next->day == slot->day)) {
+		return;
+	}
+
+	if(energy_log.day_covered) {
+		if(energy_log.pending_daily) {
+			energy_log.data_points_dropped++;
+		}
+
+		SetSDEnergyManagerDailyDataPoint *dp = &energy_log.daily_data_point;
+		dp->year            = slot->year;
+		dp->month           = slot->month;
+		dp->day             = slot->day;
+		dp->energy_grid_in  = energy_log_get_daily_energy(energy_log.day_energy_in);
+		dp->energy_grid_out = energy_log_get_daily_energy(energy_log.day_energy_out);
+		memcpy(dp->energy_general_in,  energy_log.energy_general_in,  sizeof(dp->energy_general_in));
+		memcpy(dp->energy_general_out, energy_log.energy_general_out, sizeof(dp->energy_general_out));
+		dp->price           = energy_log.daily_price;
+		energy_log.pending_daily = true;
+	}
+	energy_log_reset_day();
+}
+
+static bool energy_log_meter_is_fresh(const uint32_t now) {
+	if(!meter.each_value_read_once) {
+		return false;
+	}
+
+	// meter_register_set keeps the last values while the meter does not answer
+	if(rs485.modbus_common_error_counters.timeout != energy_log.meter_timeout_count) {
+		energy_log.meter_timeout_count = rs485.modbus_common_error_counters.timeout;
+		energy_log.meter_timeout_time  = now;
+		energy_log.meter_timeout_seen  = true;
+	}
+
+	return !energy_log.meter_timeout_seen || ((now - energy_log.meter_timeout_time) >= ENERGY_LOG_METER_TIMEOUT_MS);
+}
+
+static void energy_log_integrate(const uint32_t now, const uint32_t elapsed) {
+	if(!energy_log_meter_is_fresh(now)) {
+		return;
+	}
+
+	// Sample and hold of the last power value, the meter is read much more
+	// often than ENERGY_LOG_CHECK_INTERVAL_MS
+	const float power = meter_register_set.PowerActiveLSumImExDiff.f;
+	if(!isfinite(power)) {
+		return;
+	}
+
+	const int64_t energy = (int64_t)(power * (float)elapsed);
+	energy_log.slot_energy     += energy;
+	energy_log.slot_covered_ms += elapsed;
+	energy_log.day_covered      = true;
+	if(energy >= 0) {
+		energy_log.day_energy_in  += (uint64_t)energy;
+	} else {
+		energy_log.day_energy_out += (uint64_t)(-energy);
+	}
+}
+
+uint32_t energy_log_get_daily_energy(const uint64_t energy) {
+	return (uint32_t)(energy / (energy_log.daily_unit_wh * ENERGY_LOG_WMS_PER_WH));
+}
+
+static void energy_log_set_enabled(const bool enabled) {
+	if(enabled && !energy_log.enabled) {
+		energy_log.last_check          = system_timer_get_ms();
+		energy_log.slot_valid          = false;
+		energy_log.meter_timeout_count = rs485.modbus_common_error_counters.timeout;
+		energy_log.meter_timeout_seen  = false;
+	}
+
+	energy_log.enabled = enabled;
+}
+
+void energy_log_set_configuration(const bool enabled, const uint16_t daily_unit_wh) {
+	if((enabled != energy_log.enabled) || (daily_unit_wh != energy_log.daily_unit_wh)) {
+		energy_log.save_config = true;
+	}
+
+	energy_log_set_enabled(enabled);
+	energy_log.daily_unit_wh = daily_unit_wh;
+}
+
+static void energy_log_load_config(void) {
+	uint32_t page[ENERGY_LOG_EEPROM_PAGE_SIZE/sizeof(uint32_t)];
+	bootloader_read_eeprom_page(ENERGY_LOG_EEPROM_PAGE, page);
+
+	// The magic number is not where it is supposed to be.
+	// This is either our first startup or something went wrong.
+	// We initialize the config data with sane default values.
+	if(page[ENERGY_LOG_EEPROM_MAGIC_POSITION] != ENERGY_LOG_EEPROM_MAGIC) {
+		energy_log.daily_unit_wh = ENERGY_LOG_DAILY_UNIT_WH_DEFAULT;
+		return;
+	}
+
+	energy_log.daily_unit_wh = page[ENERGY_LOG_EEPROM_DAILY_UNIT_POSITION];
+	if(energy_log.daily_unit_wh == 0) {
+		energy_log.daily_unit_wh = ENERGY_LOG_DAILY_UNIT_WH_DEFAULT;
+	}
+	energy_log_set_enabled(page[ENERGY_LOG_EEPROM_ENABLED_POSITION] != 0);
+}
+
+// Called from the tick, writing a flash page takes a few ms
+static void energy_log_save_config(void) {
+	uint32_t page[ENERGY_LOG_EEPROM_PAGE_SIZE/sizeof(uint32_t)];
+	memset(page, 0, ENERGY_LOG_EEPROM_PAGE_SIZE);
+
+	page[ENERGY_LOG_EEPROM_MAGIC_POSITION]      = ENERGY_LOG_EEPROM_MAGIC;
+	page[ENERGY_LOG_EEPROM_ENABLED_POSITION]    = energy_log.enabled;
+	page[ENERGY_LOG_EEPROM_DAILY_UNIT_POSITION] = energy_log.daily_unit_wh;
+
+	bootloader_write_eeprom_page(ENERGY_LOG_EEPROM_PAGE, page);
+}
+
+void energy_log_tick(void) {
+	if(energy_log.save_config) {
+		energy_log.save_config = false;
+		energy_log_save_config();
+	}
+
+	if(!energy_log.enabled) {
+		return;
+	}
+
+	if(!system_timer_is_time_elapsed_ms(energy_log.last_check, ENERGY_LOG_CHECK_INTERVAL_MS)) {
+		return;
+	}
+
+	const uint32_t now     = system_timer_get_ms();
+	const uint32_t elapsed = now - energy_log.last_check;
+	energy_log.last_check  = now;
+
+	EnergyLogSlot slot;
+	if(!energy_log_get_slot(&slot)) {
+		energy_log.slot_valid = false;
+	} else if(!energy_log.slot_valid) {
+		// Start with the first full check interval after enable or RTC set
+		energy_log.slot       = slot;
+		energy_log.slot_valid = true;
+		energy_log_reset_slot();
+		energy_log_reset_day();
+	} else {
+		energy_log_integrate(now, elapsed);
+		if(memcmp(&slot, &energy_log.slot, sizeof(EnergyLogSlot)) != 0) {
+			energy_log_finish_slot(&slot);
+			energy_log.slot = slot;
+		}
+	}
+
+	energy_log_queue();
+}
+
+void energy_log_init(void) {
+	memset(&energy_log, 0, sizeof(EnergyLog));
+
+	for(uint8_t i = 0; i < 6; i++) {
+		energy_log.power_general[i]      = ENERGY_LOG_POWER_UNKNOWN;
+		energy_log.energy_general_in[i]  = ENERGY_LOG_ENERGY_UNKNOWN;
+		energy_log.energy_general_out[i] = ENERGY_LOG_ENERGY_UNKNOWN;
+	}
+
+	energy_log_load_config();
+}
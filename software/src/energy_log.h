@@ -0,0 +1,115 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * energy_log.h: Autonomous 5 minute and daily energy manager data points
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef ENERGY_LOG_H
+#define ENERGY_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "communication.h"
+
+#define ENERGY_LOG_CHECK_INTERVAL_MS 100
+
+// After a Modbus timeout the held meter values are considered stale for this
+// long and the time is not part of the average power of the 5 minute slot.
+// A meter that does not answer at all times out again well within this time.
+#define ENERGY_LOG_METER_TIMEOUT_MS  5000
+
+// The RTC is not set before the Brick called set_date_time
+#define ENERGY_LOG_MIN_YEAR 2020
+
+// Unit of the daily energies in Wh. The Brick passes the unit of its daily data
+// points with set_energy_log_configuration. The esp32-firmware energy analysis
+// (em_energy_analysis) stores them in 10 Wh (kWh*100), which is the default.
+#define ENERGY_LOG_DAILY_UNIT_WH_DEFAULT 10
+#define ENERGY_LOG_WMS_PER_WH (60ULL*60*1000)
+
+// Configuration survives a restart of the Bricklet, so that no data points are
+// lost while the Brick reboots. Page 0 belongs to the bootloader, eeprom.c keeps its
+// configuration in page 1.
+#define ENERGY_LOG_EEPROM_PAGE                 3
+#define ENERGY_LOG_EEPROM_PAGE_SIZE            256
+#define ENERGY_LOG_EEPROM_MAGIC_POSITION       0
+#define ENERGY_LOG_EEPROM_ENABLED_POSITION     1
+#define ENERGY_LOG_EEPROM_DAILY_UNIT_POSITION  2
+#define ENERGY_LOG_EEPROM_MAGIC                0x454C4F47 // "ELOG"
+
+// Values the Brick did not provide yet
+#define ENERGY_LOG_POWER_UNKNOWN  INT32_MAX
+#define ENERGY_LOG_ENERGY_UNKNOWN UINT32_MAX
+
+typedef struct {
+	uint8_t year;   // Years since 2000
+	uint8_t month;  // 1-12
+	uint8_t day;    // 1-31
+	uint8_t hour;   // 0-23
+	uint8_t minute; // 0-55, start of the 5 minute slot
+} EnergyLogSlot;
+
+typedef struct {
+	bool enabled;
+	uint16_t daily_unit_wh;
+	bool save_config;
+
+	uint32_t last_check;
+	bool slot_valid;
+
+	// Last change of the Modbus timeout counter
+	uint32_t meter_timeout_count;
+	uint32_t meter_timeout_time;
+	bool meter_timeout_seen;
+	EnergyLogSlot slot;
+
+	// Grid power integrated over the current 5 minute slot and the current day
+	int64_t slot_energy;      // W*ms
+	uint32_t slot_covered_ms;
+	uint64_t day_energy_in;   // W*ms
+	uint64_t day_energy_out;  // W*ms
+	bool day_covered;
+
+	// Set by the Brick, used for the next data points
+	uint8_t flags;
+	int32_t power_general[6];
+	uint32_t price;
+	uint32_t energy_general_in[6];
+	uint32_t energy_general_out[6];
+	uint32_t daily_price;
+
+	// Data points that did not fit into the SD queue yet
+	bool pending;
+	bool pending_daily;
+	SetSDEnergyManagerDataPoint data_point;
+	SetSDEnergyManagerDailyDataPoint daily_data_point;
+
+	uint32_t data_points_written;
+	uint32_t data_points_dropped;
+} EnergyLog;
+
+extern EnergyLog energy_log;
+
+void energy_log_set_configuration(const bool enabled, const uint16_t daily_unit_wh);
+uint32_t energy_log_get_daily_energy(const uint64_t energy);
+
+void energy_log_tick(void);
+void energy_log_init(void);
+
+#endif
@@ -28,6 +28,8 @@
 #include "bricklib2/hal/system_timer/system_timer.h"
 #include "bricklib2/logging/logging.h"
 
+#include "io_sequence.h"
+
 IO io;
 
 bool io_get_contactor_check(void) {
@@ -55,6 +57,13 @@ bool io_get_contactor_check(void) {
 	return true;
 }
 
+// Contactor pin follows io.contactor and the contactor check input reached the new state
+bool io_contactor_is_settled(void) {
+	// Contactor pin active low, contactor check pin active low
+	const bool contactor_pin = XMC_GPIO_GetInput(IO_CONTACTOR_PIN);
+	return (contactor_pin != io.contactor) && (contactor_pin == XMC_GPIO_GetInput(IO_INPUT1_PIN));
+}
+
 void io_init(void) {
 	memset(&io, 0, sizeof(IO));
 	const XMC_GPIO_CONFIG_t io_config_high = {
@@ -80,6 +89,8 @@ void io_init(void) {
 }
 
 void io_tick(void) {
+	io_sequence_tick();
+
 	if(system_timer_is_time_elapsed_ms(io.contactor_change_time, IO_CONTACTOR_CHANGE_WAIT_TIME)) {
 		io.contactor_change_time = 0;
 	}
@@ -44,5 +44,6 @@ extern IO io;
 void io_init(void);
 void io_tick(void);
 bool io_get_contactor_check(void);
+bool io_contactor_is_settled(void);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * io_sequence.c: Timed contactor/output sequences executed from io_tick
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "io_sequence.h"
+
+#include <string.h>
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+
+#include "io.h"
+
+// A phase switch done by the Brick needs several set_contactor/set_output
+// calls with waits in between, each with SPITFP round trip jitter. The
+// Brick can instead upload the whole sequence, we run it from io_tick with
+// ms timing and report the result with a callback. The wait steps are
+// scheduled relative to the planned start of the step, so a late tick does
+// not delay the rest of the sequence.
+
+IOSequence io_sequence;
+
+static void io_sequence_finish(const IOSequenceResult result) {
+	io_sequence.running     = false;
+	io_sequence.done        = true;
+	io_sequence.result      = result;
+	io_sequence.result_step = io_sequence.step;
+	io_sequence.duration    = system_timer_get_ms() - io_sequence.start_time;
+}
+
+bool io_sequence_start(const uint8_t *command, const void *argument, const uint8_t length) {
+	if(io_sequence.running) {
+		return false;
+	}
+
+	memcpy(io_sequence.command,  command,  length*sizeof(uint8_t));
+	memcpy(io_sequence.argument, argument, length*sizeof(uint16_t));
+	io_sequence.length     = length;
+	io_sequence.step       = 0;
+	io_sequence.start_time = system_timer_get_ms();
+	io_sequence.step_time  = io_sequence.start_time;
+	io_sequence.done       = false;
+	io_sequence.running    = true;
+
+	// Immediate steps are done right away, not with the next io_tick
+	io_sequence_tick();
+
+	return true;
+}
+
+void io_sequence_abort(void) {
+	if(io_sequence.running) {
+		io_sequence_finish(IO_SEQUENCE_RESULT_ABORTED);
+	}
+}
+
+void io_sequence_tick(void) {
+	if(!io_sequence.running) {
+		return;
+	}
+
+	// The contactor check is blanked while the contactor switches
+	if(!io_get_contactor_check()) {
+		io_sequence_finish(IO_SEQUENCE_RESULT_CONTACTOR_CHECK_FAILED);
+		return;
+	}
+
+	while(io_sequence.step < io_sequence.length) {
+		const uint16_t argument = io_sequence.argument[io_sequence.step];
+
+		switch(io_sequence.command[io_sequence.step]) {
+			case IO_SEQUENCE_COMMAND_SET_CONTACTOR: {
+				io.contactor = argument != 0;
+				break;
+			}
+
+			case IO_SEQUENCE_COMMAND_SET_OUTPUT: {
+				io.output = argument != 0;
+				break;
+			}
+
+			case IO_SEQUENCE_COMMAND_WAIT: {
+				if(!system_timer_is_time_elapsed_ms(io_sequence.step_time, argument)) {
+					return;
+				}
+				io_sequence.step_time += argument;
+				break;
+			}
+
+			case IO_SEQUENCE_COMMAND_VERIFY_CONTACTOR: {
+				if(!io_contactor_is_settled()) {
+					if(system_timer_is_time_elapsed_ms(io_sequence.step_time, argument)) {
+						io_sequence_finish(IO_SEQUENCE_RESULT_TIMEOUT);
+					}
+					return;
+				}
+				io_sequence.step_time = system_timer_get_ms();
+				break;
+			}
+
+			default: break; // Checked in start_io_sequence
+		}
+
+		io_sequence.step++;
+	}
+
+	io_sequence_finish(IO_SEQUENCE_RESULT_OK);
+}
+
+void io_sequence_init(void) {
+	memset(&io_sequence, 0, sizeof(IOSequence));
+}
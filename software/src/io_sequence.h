@@ -0,0 +1,73 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * io_sequence.h: Timed contactor/output sequences executed from io_tick
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef IO_SEQUENCE_H
+#define IO_SEQUENCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 1 + 16*3 = 49 bytes fit into the 64 byte StartIOSequence payload
+#define IO_SEQUENCE_STEP_NUM 16
+
+// Order has to match the WARP_ENERGY_MANAGER_IO_SEQUENCE_COMMAND_* constants
+typedef enum {
+	IO_SEQUENCE_COMMAND_SET_CONTACTOR = 0, // Argument: 0 = off, 1 = on
+	IO_SEQUENCE_COMMAND_SET_OUTPUT,        // Argument: 0 = off, 1 = on
+	IO_SEQUENCE_COMMAND_WAIT,              // Argument: time in ms
+	IO_SEQUENCE_COMMAND_VERIFY_CONTACTOR,  // Argument: timeout in ms until the contactor check settled
+	IO_SEQUENCE_COMMAND_NUM
+} IOSequenceCommand;
+
+// Order has to match the WARP_ENERGY_MANAGER_IO_SEQUENCE_RESULT_* constants
+typedef enum {
+	IO_SEQUENCE_RESULT_OK = 0,
+	IO_SEQUENCE_RESULT_CONTACTOR_CHECK_FAILED,
+	IO_SEQUENCE_RESULT_TIMEOUT,
+	IO_SEQUENCE_RESULT_ABORTED
+} IOSequenceResult;
+
+typedef struct {
+	uint8_t command[IO_SEQUENCE_STEP_NUM];
+	uint16_t argument[IO_SEQUENCE_STEP_NUM];
+	uint8_t length;
+
+	bool running;
+	uint8_t step;
+	uint32_t start_time;
+	uint32_t step_time; // Scheduled start of the current step
+
+	// Result of the last sequence, done is cleared when the callback was sent
+	bool done;
+	IOSequenceResult result;
+	uint8_t result_step;
+	uint32_t duration;
+} IOSequence;
+
+extern IOSequence io_sequence;
+
+bool io_sequence_start(const uint8_t *command, const void *argument, const uint8_t length);
+void io_sequence_abort(void);
+
+void io_sequence_tick(void);
+void io_sequence_init(void);
+
+#endif
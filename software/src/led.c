@@ -104,6 +104,89 @@ void led_ccu4_pwm_init(XMC_GPIO_PORT_t *const port, const uint8_t pin, const uin
     XMC_CCU4_SLICE_StartTimer(slice[ccu4_slice_number]);
 }
 
+static uint16_t led_duration_to_frames(const uint32_t duration) {
+	return MAX(1, MIN(UINT16_MAX, duration / LED_FRAME_TIME));
+}
+
+void led_set_sequence_keyframe(const uint8_t index, const uint8_t r, const uint8_t g, const uint8_t b, const bool fade, const uint16_t duration) {
+	LEDKeyframe *keyframe = &led.sequence.keyframe[index];
+	keyframe->r      = r;
+	keyframe->g      = g;
+	keyframe->b      = b;
+	keyframe->fade   = fade;
+	keyframe->frames = led_duration_to_frames(duration);
+}
+
+// Restarts the sequence with the next led_tick, e.g. after the Brick uploaded a new one
+void led_restart_sequence(void) {
+	led.sequence_shown = false;
+}
+
+static void led_enter_keyframe(const LEDKeyframe *keyframe) {
+	if(!keyframe->fade) {
+		led.sequence_r = keyframe->r << 8;
+		led.sequence_g = keyframe->g << 8;
+		led.sequence_b = keyframe->b << 8;
+	}
+}
+
+// The divisions for the fades are done here once per keyframe instead of in every frame
+static void led_start_sequence(void) {
+	for(uint8_t i = 0; i < led.sequence.length; i++) {
+		LEDKeyframe *keyframe = &led.sequence.keyframe[i];
+		if(keyframe->fade) {
+			const LEDKeyframe *previous = &led.sequence.keyframe[(i == 0) ? (led.sequence.length - 1) : (i - 1)];
+			keyframe->delta_r = (keyframe->r - previous->r)*256 / keyframe->frames;
+			keyframe->delta_g = (keyframe->g - previous->g)*256 / keyframe->frames;
+			keyframe->delta_b = (keyframe->b - previous->b)*256 / keyframe->frames;
+		}
+	}
+
+	const LEDKeyframe *last = &led.sequence.keyframe[led.sequence.length - 1];
+	led.sequence_index        = 0;
+	led.sequence_frame        = 0;
+	led.sequence_repeat_count = 0;
+	led.sequence_frame_time   = system_timer_get_ms();
+	led.sequence_r            = last->r << 8;
+	led.sequence_g            = last->g << 8;
+	led.sequence_b            = last->b << 8;
+	led.sequence_running      = true;
+	led_enter_keyframe(&led.sequence.keyframe[0]);
+}
+
+// One frame of LED_FRAME_TIME, only additions here
+static void led_step_sequence(void) {
+	const LEDKeyframe *keyframe = &led.sequence.keyframe[led.sequence_index];
+	led.sequence_frame++;
+	if(led.sequence_frame >= keyframe->frames) {
+		// Land exactly on the keyframe color, the deltas are rounded
+		led.sequence_r = keyframe->r << 8;
+		led.sequence_g = keyframe->g << 8;
+		led.sequence_b = keyframe->b << 8;
+
+		led.sequence_frame = 0;
+		led.sequence_index++;
+		if(led.sequence_index >= led.sequence.length) {
+			led.sequence_index = 0;
+			if(led.sequence.repeat != 0) {
+				led.sequence_repeat_count++;
+				if(led.sequence_repeat_count >= led.sequence.repeat) {
+					// Keep the color of the last keyframe
+					led.sequence_running = false;
+				}
+			}
+		}
+
+		if(led.sequence_running) {
+			led_enter_keyframe(&led.sequence.keyframe[led.sequence_index]);
+		}
+	} else if(keyframe->fade) {
+		led.sequence_r += keyframe->delta_r;
+		led.sequence_g += keyframe->delta_g;
+		led.sequence_b += keyframe->delta_b;
+	}
+}
+
 void led_init(void) {
 	const XMC_GPIO_CONFIG_t output_config = {
 		.mode         = XMC_GPIO_MODE_OUTPUT_PUSH_PULL,
@@ -191,6 +274,11 @@ void led_tick(void) {
 		}
 	}
 
+	// The sequence starts from the beginning whenever it is shown again
+	if(led.use_rgb || (led.pattern != WARP_ENERGY_MANAGER_LED_PATTERN_SEQUENCE)) {
+		led.sequence_shown = false;
+	}
+
 	if(led.use_rgb) {
 		set_r = led.r;
 		set_g = led.g;
@@ -246,6 +334,30 @@ void led_tick(void) {
 					led.breathing_up = false;
 				}
 				led_hsv_to_rgb(led.hue, 255, led.breathing_index, &set_r, &set_g, &set_b);
+			} else if(led.pattern == WARP_ENERGY_MANAGER_LED_PATTERN_SEQUENCE) {
+				if(!led.sequence_shown) {
+					led.sequence_shown = true;
+					if(led.sequence.length == 0) {
+						led.sequence_running = false;
+						led.sequence_r       = 0;
+						led.sequence_g       = 0;
+						led.sequence_b       = 0;
+					} else {
+						led_start_sequence();
+					}
+				} else if(!led.sequence_running || !system_timer_is_time_elapsed_ms(led.sequence_frame_time, LED_FRAME_TIME)) {
+					return;
+				} else {
+					// Catch up on frames if the main loop was slow
+					while(led.sequence_running && system_timer_is_time_elapsed_ms(led.sequence_frame_time, LED_FRAME_TIME)) {
+						led.sequence_frame_time += LED_FRAME_TIME;
+						led_step_sequence();
+					}
+				}
+
+				set_r = led.sequence_r >> 8;
+				set_g = led.sequence_g >> 8;
+				set_b = led.sequence_b >> 8;
 			} else {
 				logw("Unknown pattern: %d\n\r", led.pattern);
 			}
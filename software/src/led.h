@@ -31,6 +31,30 @@
 
 #define LED_CONNETION_LOST_TIME 15000 // in ms
 
+#define LED_KEYFRAME_NUM        10
+
+// A keyframe shows its color for duration frames. With fade the color
+// is faded from the previous keyframe's color to this one instead.
+typedef struct {
+	uint8_t r;
+	uint8_t g;
+	uint8_t b;
+	bool fade;
+	uint16_t frames;
+
+	// Per frame color change in 8.8 fixed point, precomputed so that the
+	// frames do not have to divide
+	int32_t delta_r;
+	int32_t delta_g;
+	int32_t delta_b;
+} LEDKeyframe;
+
+typedef struct {
+	LEDKeyframe keyframe[LED_KEYFRAME_NUM];
+	uint8_t length;
+	uint8_t repeat; // 0 = forever
+} LEDSequence;
+
 typedef struct {
 	uint8_t r;
 	uint8_t g;
@@ -49,6 +73,18 @@ typedef struct {
 	int16_t breathing_index;
 	bool breathing_up;
 
+	// Sequence uploaded by the Brick, shown with the sequence pattern
+	LEDSequence sequence;
+	bool sequence_shown;
+	bool sequence_running;
+	uint8_t sequence_index;
+	uint8_t sequence_repeat_count;
+	uint16_t sequence_frame;
+	uint32_t sequence_frame_time;
+	int32_t sequence_r;
+	int32_t sequence_g;
+	int32_t sequence_b;
+
 	uint32_t connection_lost_time;
 
 	bool connection_lost_saved;
@@ -64,5 +100,7 @@ extern LED led;
 
 void led_init(void);
 void led_tick(void);
+void led_set_sequence_keyframe(const uint8_t index, const uint8_t r, const uint8_t g, const uint8_t b, const bool fade, const uint16_t duration);
+void led_restart_sequence(void);
 
 #endif
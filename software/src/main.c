@@ -32,38 +32,53 @@
 #include "communication.h"
 
 #include "io.h"
+#include "io_sequence.h"
 #include "led.h"
 #include "voltage.h"
+#include "voltage_monitor.h"
 #include "eeprom.h"
 #include "date_time.h"
 #include "sd.h"
 #include "data_storage.h"
+#include "profiler.h"
+#include "sd_queue.h"
+#include "energy_log.h"
 
 int main(void) {
 	logging_init();
 	logd("Start WARP Energy Manager Bricklet\n\r");
 
+	profiler_init();
 	communication_init();
 	io_init();
+	io_sequence_init();
 	led_init();
 	rs485_init();
 	meter_init();
+	energy_log_init();
 	voltage_init();
+	voltage_monitor_init();
 	eeprom_init();
 	date_time_init();
 	data_storage_init();
 	sd_init();
+	sd_queue_init();
 
 	while(true) {
-		bootloader_tick();
-		communication_tick();
-		io_tick();
-		led_tick();
-		rs485_tick();
-		meter_tick();
-		voltage_tick();
-		date_time_tick();
-		sd_tick();
-		data_storage_tick();
+		profiler_loop_begin();
+		bootloader_tick();      profiler_tick_end(PROFILER_TICK_BOOTLOADER);
+		communication_tick();   profiler_tick_end(PROFILER_TICK_COMMUNICATION);
+		io_tick();              profiler_tick_end(PROFILER_TICK_IO);
+		led_tick();             profiler_tick_end(PROFILER_TICK_LED);
+		rs485_tick();           profiler_tick_end(PROFILER_TICK_RS485);
+		meter_tick();           profiler_tick_end(PROFILER_TICK_METER);
+		energy_log_tick();      profiler_tick_end(PROFILER_TICK_ENERGY_LOG);
+		voltage_tick();         profiler_tick_end(PROFILER_TICK_VOLTAGE);
+		voltage_monitor_tick(); profiler_tick_end(PROFILER_TICK_VOLTAGE_MONITOR);
+		date_time_tick();       profiler_tick_end(PROFILER_TICK_DATE_TIME);
+		sd_queue_tick();        profiler_tick_end(PROFILER_TICK_SD_QUEUE);
+		sd_tick();              profiler_tick_end(PROFILER_TICK_SD);
+		data_storage_tick();    profiler_tick_end(PROFILER_TICK_DATA_STORAGE);
+		profiler_loop_end();
 	}
 }
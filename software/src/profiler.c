@@ -0,0 +1,127 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * profiler.c: Cycle accounting for the main loop tick functions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "profiler.h"
+
+#include <string.h>
+
+#include "configs/config.h"
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+
+Profiler profiler;
+
+// The Cortex-M0 has no cycle counter (no DWT), so we combine the millisecond
+// counter of the system timer with the current SysTick down-counter value.
+// The result wraps around after 2^32 cycles (~89s at 48MHz), which is fine
+// for measuring differences of a few milliseconds.
+uint32_t profiler_get_cycles(void) {
+	uint32_t ms;
+	uint32_t value;
+
+	// Read again if the SysTick interrupt incremented the ms counter in between
+	do {
+		ms    = system_timer_get_ms();
+		value = SysTick->VAL;
+	} while(ms != system_timer_get_ms());
+
+	return ms*profiler.cycles_per_ms + (profiler.cycles_per_ms - 1 - value);
+}
+
+uint32_t profiler_cycles_to_us(const uint32_t cycles) {
+	return cycles / profiler.cycles_per_us;
+}
+
+ProfilerStatisticsUs profiler_get_statistics_us(const ProfilerStatistics *statistics) {
+	ProfilerStatisticsUs statistics_us = {0};
+	if(statistics->count == 0) {
+		return statistics_us;
+	}
+
+	statistics_us.count = statistics->count;
+	statistics_us.min   = profiler_cycles_to_us(statistics->min);
+	statistics_us.avg   = profiler_cycles_to_us((uint32_t)(statistics->sum / statistics->count));
+	statistics_us.max   = profiler_cycles_to_us(statistics->max);
+
+	return statistics_us;
+}
+
+static inline void profiler_add_statistics(ProfilerStatistics *statistics, const uint32_t cycles) {
+	statistics->count++;
+	statistics->sum += cycles;
+	if(cycles < statistics->min) {
+		statistics->min = cycles;
+	}
+	if(cycles > statistics->max) {
+		statistics->max = cycles;
+	}
+}
+
+void profiler_reset(void) {
+	memset(profiler.tick, 0, sizeof(profiler.tick));
+	memset(&profiler.loop, 0, sizeof(profiler.loop));
+	memset(profiler.histogram, 0, sizeof(profiler.histogram));
+
+	for(uint8_t i = 0; i < PROFILER_TICK_NUM; i++) {
+		profiler.tick[i].min = UINT32_MAX;
+	}
+	profiler.loop.min = UINT32_MAX;
+}
+
+void profiler_loop_begin(void) {
+	profiler.loop_start = profiler_get_cycles();
+	profiler.mark       = profiler.loop_start;
+}
+
+void profiler_tick_end(const ProfilerTick tick) {
+	const uint32_t now = profiler_get_cycles();
+	profiler_add_statistics(&profiler.tick[tick], now - profiler.mark);
+	profiler.mark = now;
+}
+
+void profiler_loop_end(void) {
+	const uint32_t cycles = profiler.mark - profiler.loop_start;
+	profiler_add_statistics(&profiler.loop, cycles);
+
+	// Linear search over the precomputed limits, this avoids a division per loop
+	uint8_t bucket = 0;
+	while((bucket < (PROFILER_HISTOGRAM_BUCKETS-1)) && (cycles >= profiler.histogram_limit[bucket])) {
+		bucket++;
+	}
+	profiler.histogram[bucket]++;
+}
+
+void profiler_init(void) {
+	memset(&profiler, 0, sizeof(Profiler));
+
+	// SysTick is configured with a reload value of SystemCoreClock/SYSTEM_TIMER_FREQUENCY
+	profiler.cycles_per_ms = SystemCoreClock / SYSTEM_TIMER_FREQUENCY;
+	profiler.cycles_per_us = SystemCoreClock / 1000000;
+	if(profiler.cycles_per_us == 0) {
+		profiler.cycles_per_us = 1;
+	}
+
+	for(uint8_t i = 0; i < (PROFILER_HISTOGRAM_BUCKETS-1); i++) {
+		profiler.histogram_limit[i] = (PROFILER_HISTOGRAM_BASE_US << i) * profiler.cycles_per_us;
+	}
+
+	profiler_reset();
+}
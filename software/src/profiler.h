@@ -0,0 +1,92 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * profiler.h: Cycle accounting for the main loop tick functions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Loop duration histogram: Bucket i counts loops that took less than
+// PROFILER_HISTOGRAM_BASE_US << i, the last bucket counts everything above.
+#define PROFILER_HISTOGRAM_BUCKETS 12
+#define PROFILER_HISTOGRAM_BASE_US 32
+
+// Order has to match the WARP_ENERGY_MANAGER_TICK_* constants
+typedef enum {
+	PROFILER_TICK_BOOTLOADER = 0,
+	PROFILER_TICK_COMMUNICATION,
+	PROFILER_TICK_IO,
+	PROFILER_TICK_LED,
+	PROFILER_TICK_RS485,
+	PROFILER_TICK_METER,
+	PROFILER_TICK_VOLTAGE,
+	PROFILER_TICK_DATE_TIME,
+	PROFILER_TICK_SD,
+	PROFILER_TICK_DATA_STORAGE,
+	PROFILER_TICK_SD_QUEUE,
+	PROFILER_TICK_ENERGY_LOG,
+	PROFILER_TICK_VOLTAGE_MONITOR,
+	PROFILER_TICK_NUM
+} ProfilerTick;
+
+// All durations are in cycles, they are only converted to us when read
+typedef struct {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+} ProfilerStatistics;
+
+typedef struct {
+	uint32_t count;
+	uint32_t min;
+	uint32_t avg;
+	uint32_t max;
+} ProfilerStatisticsUs;
+
+typedef struct {
+	uint32_t cycles_per_ms;
+	uint32_t cycles_per_us;
+	uint32_t histogram_limit[PROFILER_HISTOGRAM_BUCKETS-1];
+
+	uint32_t loop_start;
+	uint32_t mark;
+
+	ProfilerStatistics tick[PROFILER_TICK_NUM];
+	ProfilerStatistics loop;
+	uint32_t histogram[PROFILER_HISTOGRAM_BUCKETS];
+} Profiler;
+
+extern Profiler profiler;
+
+uint32_t profiler_get_cycles(void);
+uint32_t profiler_cycles_to_us(const uint32_t cycles);
+ProfilerStatisticsUs profiler_get_statistics_us(const ProfilerStatistics *statistics);
+void profiler_reset(void);
+
+void profiler_loop_begin(void);
+void profiler_tick_end(const ProfilerTick tick);
+void profiler_loop_end(void);
+
+void profiler_init(void);
+
+#endif
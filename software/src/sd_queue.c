@@ -0,0 +1,113 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * sd_queue.c: Fill level and flush latency of the SD write queues
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "sd_queue.h"
+
+#include <string.h>
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+
+#include "sd.h"
+
+SDQueue sd_queue;
+
+uint8_t sd_queue_get_fill(const SDQueueType type) {
+	switch(type) {
+		case SD_QUEUE_WALLBOX:              return sd.wallbox_data_point_end;
+		case SD_QUEUE_WALLBOX_DAILY:        return sd.wallbox_daily_data_point_end;
+		case SD_QUEUE_ENERGY_MANAGER:       return sd.energy_manager_data_point_end;
+		case SD_QUEUE_ENERGY_MANAGER_DAILY: return sd.energy_manager_daily_data_point_end;
+		default:                            return 0;
+	}
+}
+
+uint8_t sd_queue_get_capacity(const SDQueueType type) {
+	switch(type) {
+		case SD_QUEUE_WALLBOX:              return SD_WALLBOX_DATA_POINT_LENGTH;
+		case SD_QUEUE_WALLBOX_DAILY:        return SD_WALLBOX_DAILY_DATA_POINT_LENGTH;
+		case SD_QUEUE_ENERGY_MANAGER:       return SD_ENERGY_MANAGER_DATA_POINT_LENGTH;
+		case SD_QUEUE_ENERGY_MANAGER_DAILY: return SD_ENERGY_MANAGER_DAILY_DATA_POINT_LENGTH;
+		default:                            return 0;
+	}
+}
+
+uint32_t sd_queue_get_oldest_age(const SDQueueType type) {
+	if(sd_queue.queue[type].group_num == 0) {
+		return 0;
+	}
+
+	return system_timer_get_ms() - sd_queue.queue[type].group[0].time;
+}
+
+// Has to be called by everything that appends to one of the sd write queues
+void sd_queue_add(const SDQueueType type, const uint8_t count) {
+	SDQueueState *state = &sd_queue.queue[type];
+	const uint32_t time = system_timer_get_ms();
+
+	state->queued += count;
+
+	// Same loop or no free group: Count the new entries to the newest group.
+	// Its time is then too old for them, so the age stays an upper bound.
+	if((state->group_num > 0) && ((state->group_num == SD_QUEUE_GROUP_NUM) || (state->group[state->group_num-1].time == time))) {
+		state->group[state->group_num-1].count += count;
+		return;
+	}
+
+	state->group[state->group_num].time  = time;
+	state->group[state->group_num].count = count;
+	state->group_num++;
+}
+
+// Called once per loop. The sd task writes the queues in order, so
+// everything that was added but is not in the queue anymore has been
+// written from the oldest group on. This also works during a sustained
+// backfill where the queue never runs empty.
+void sd_queue_tick(void) {
+	const uint32_t time = system_timer_get_ms();
+
+	for(uint8_t i = 0; i < SD_QUEUE_NUM; i++) {
+		SDQueueState *state = &sd_queue.queue[i];
+		const uint8_t fill  = sd_queue_get_fill(i);
+		if(fill >= state->queued) {
+			continue;
+		}
+
+		uint8_t written = state->queued - fill;
+		state->queued   = fill;
+
+		while((written > 0) && (state->group_num > 0)) {
+			SDQueueGroup *oldest = &state->group[0];
+			if(oldest->count > written) {
+				oldest->count -= written;
+				break;
+			}
+
+			written                   -= oldest->count;
+			state->last_flush_duration = time - oldest->time;
+			state->group_num--;
+			memmove(&state->group[0], &state->group[1], state->group_num*sizeof(SDQueueGroup));
+		}
+	}
+}
+
+void sd_queue_init(void) {
+	memset(&sd_queue, 0, sizeof(SDQueue));
+}
@@ -0,0 +1,66 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * sd_queue.h: Fill level and flush latency of the SD write queues
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SD_QUEUE_H
+#define SD_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Order has to match the WARP_ENERGY_MANAGER_SD_QUEUE_* constants
+typedef enum {
+	SD_QUEUE_WALLBOX = 0,
+	SD_QUEUE_WALLBOX_DAILY,
+	SD_QUEUE_ENERGY_MANAGER,
+	SD_QUEUE_ENERGY_MANAGER_DAILY,
+	SD_QUEUE_NUM
+} SDQueueType;
+
+// Entries that were queued in the same loop share one timestamp
+#define SD_QUEUE_GROUP_NUM 4
+
+typedef struct {
+	uint32_t time;                // Time the entries of this group were queued
+	uint8_t count;                // Entries of this group that are not written yet
+} SDQueueGroup;
+
+typedef struct {
+	SDQueueGroup group[SD_QUEUE_GROUP_NUM]; // Oldest first
+	uint8_t group_num;
+	uint8_t queued;               // Sum of all group counts
+	uint32_t last_flush_duration; // Time from queueing until the last completely written group left the queue
+} SDQueueState;
+
+typedef struct {
+	SDQueueState queue[SD_QUEUE_NUM];
+} SDQueue;
+
+extern SDQueue sd_queue;
+
+uint8_t sd_queue_get_fill(const SDQueueType type);
+uint8_t sd_queue_get_capacity(const SDQueueType type);
+uint32_t sd_queue_get_oldest_age(const SDQueueType type);
+void sd_queue_add(const SDQueueType type, const uint8_t count);
+
+void sd_queue_init(void);
+void sd_queue_tick(void);
+
+#endif
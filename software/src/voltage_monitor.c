@@ -0,0 +1,144 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * voltage_monitor.c: Input voltage statistics and brown-out write-back
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "voltage_monitor.h"
+
+#include <string.h>
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+#include "bricklib2/utility/util_definitions.h"
+
+#include "voltage.h"
+#include "data_storage.h"
+
+VoltageMonitor voltage_monitor;
+
+static bool voltage_monitor_is_active(void) {
+	return (voltage_monitor.brown_out_threshold != 0) && voltage_monitor.valid;
+}
+
+// Called by set_data_storage for every changed page. Without an active
+// brown-out detection the page goes to data_storage right away and is
+// written with the usual data_storage delay.
+void voltage_monitor_data_storage_changed(const uint8_t page) {
+	if(data_storage.last_change_time[page] != 0) {
+		return;
+	}
+
+	if(voltage_monitor_is_active() && !voltage_monitor.brown_out) {
+		if(voltage_monitor.data_storage_hold_time[page] == 0) {
+			voltage_monitor.data_storage_hold_time[page] = system_timer_get_ms() | 1; // 0 = not held
+		}
+	} else {
+		voltage_monitor.data_storage_hold_time[page] = 0;
+		data_storage.last_change_time[page]          = system_timer_get_ms() | 1;
+	}
+}
+
+bool voltage_monitor_data_storage_is_pending(const uint8_t page) {
+	return (data_storage.last_change_time[page] != 0) || (voltage_monitor.data_storage_hold_time[page] != 0);
+}
+
+// Hands held pages to data_storage. With age set, all changed pages are
+// written by the next data_storage_tick instead of waiting for the delay.
+static void voltage_monitor_release_data_storage(const bool all, const uint32_t age) {
+	const uint32_t time = (system_timer_get_ms() - age) | 1; // 0 = page not changed
+	for(uint8_t page = 0; page < DATA_STORAGE_PAGES; page++) {
+		if(voltage_monitor.data_storage_hold_time[page] != 0) {
+			if(all || system_timer_is_time_elapsed_ms(voltage_monitor.data_storage_hold_time[page], VOLTAGE_MONITOR_DATA_STORAGE_DELAY)) {
+				voltage_monitor.data_storage_hold_time[page] = 0;
+				data_storage.last_change_time[page]          = time;
+			}
+		} else if((age != 0) && (data_storage.last_change_time[page] != 0)) {
+			data_storage.last_change_time[page] = time;
+		}
+	}
+}
+
+static void voltage_monitor_reset_window(void) {
+	voltage_monitor.window_start = system_timer_get_ms();
+	voltage_monitor.window_sum   = 0;
+	voltage_monitor.window_count = 0;
+	voltage_monitor.window_min   = UINT16_MAX;
+	voltage_monitor.window_max   = 0;
+}
+
+static void voltage_monitor_end_window(void) {
+	if(voltage_monitor.window_count == 0) {
+		voltage_monitor.valid = false;
+		return;
+	}
+
+	voltage_monitor.valid = true;
+	voltage_monitor.min   = voltage_monitor.window_min;
+	voltage_monitor.max   = voltage_monitor.window_max;
+	voltage_monitor.avg   = voltage_monitor.window_sum / voltage_monitor.window_count;
+
+	if(voltage_monitor.brown_out && (voltage_monitor.avg >= voltage_monitor.brown_out_threshold + VOLTAGE_MONITOR_HYSTERESIS)) {
+		voltage_monitor.brown_out = false;
+	}
+}
+
+void voltage_monitor_set_configuration(const uint16_t brown_out_threshold, const uint16_t window) {
+	voltage_monitor.brown_out_threshold = brown_out_threshold;
+	voltage_monitor.window              = window;
+
+	voltage_monitor_reset_window();
+	if(brown_out_threshold == 0) {
+		voltage_monitor.brown_out = false;
+	}
+}
+
+void voltage_monitor_init(void) {
+	memset(&voltage_monitor, 0, sizeof(VoltageMonitor));
+	voltage_monitor.window = VOLTAGE_MONITOR_WINDOW_DEFAULT;
+	voltage_monitor_reset_window();
+}
+
+void voltage_monitor_tick(void) {
+	// voltage.value is 0 until voltage_tick has the first measurement
+	const uint16_t value = voltage.value;
+	if(value != 0) {
+		voltage_monitor.window_sum += value;
+		voltage_monitor.window_count++;
+		voltage_monitor.window_min = MIN(voltage_monitor.window_min, value);
+		voltage_monitor.window_max = MAX(voltage_monitor.window_max, value);
+
+		if(!voltage_monitor.brown_out && voltage_monitor_is_active() && (value < voltage_monitor.brown_out_threshold)) {
+			voltage_monitor.brown_out = true;
+			voltage_monitor.brown_out_count++;
+		}
+	}
+
+	if(system_timer_is_time_elapsed_ms(voltage_monitor.window_start, voltage_monitor.window)) {
+		voltage_monitor_end_window();
+		voltage_monitor_reset_window();
+	}
+
+	// Has to run before data_storage_tick. While the supply is low every change
+	// is written right away. If the detection is switched off, the held pages
+	// continue with the usual data_storage delay.
+	if(voltage_monitor.brown_out) {
+		voltage_monitor_release_data_storage(true, VOLTAGE_MONITOR_DATA_STORAGE_AGE);
+	} else {
+		voltage_monitor_release_data_storage(!voltage_monitor_is_active(), 0);
+	}
+}
@@ -0,0 +1,74 @@
+/* warp-energy-manager-bricklet
+ * Copyright (C) 2026 Olaf Lüke <olaf@tinkerforge.com>
+ *
+ * voltage_monitor.h: Input voltage statistics and brown-out write-back
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef VOLTAGE_MONITOR_H
+#define VOLTAGE_MONITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "data_storage.h"
+
+#define VOLTAGE_MONITOR_WINDOW_DEFAULT 1000 // in ms
+#define VOLTAGE_MONITOR_WINDOW_MIN     10   // in ms
+#define VOLTAGE_MONITOR_HYSTERESIS     500  // in mV, the brown-out ends above threshold + hysteresis
+
+// While the brown-out detection is active, changed data storage pages are held
+// this long before they are handed to data_storage_tick (which adds its own delay).
+#define VOLTAGE_MONITOR_DATA_STORAGE_DELAY (1000*60*20) // in ms
+
+// Age that changed data storage pages get on a brown-out,
+// data_storage_tick then writes them with its next run
+#define VOLTAGE_MONITOR_DATA_STORAGE_AGE (UINT32_MAX/2)
+
+typedef struct {
+	uint16_t brown_out_threshold; // in mV, 0 = off
+	uint16_t window;              // in ms
+
+	// Current window, sampled from voltage.value once per tick
+	uint32_t window_start;
+	uint64_t window_sum;
+	uint32_t window_count;
+	uint16_t window_min;
+	uint16_t window_max;
+
+	// Last complete window in mV
+	bool valid;
+	uint16_t min;
+	uint16_t max;
+	uint16_t avg;
+
+	bool brown_out;
+	uint32_t brown_out_count;
+
+	// Change time of data storage pages that are not handed to data_storage yet, 0 = not held
+	uint32_t data_storage_hold_time[DATA_STORAGE_PAGES];
+} VoltageMonitor;
+
+extern VoltageMonitor voltage_monitor;
+
+void voltage_monitor_data_storage_changed(const uint8_t page);
+bool voltage_monitor_data_storage_is_pending(const uint8_t page);
+void voltage_monitor_set_configuration(const uint16_t brown_out_threshold, const uint16_t window);
+void voltage_monitor_init(void);
+void voltage_monitor_tick(void);
+
+#endif
@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '26dL'
+
+import sys
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_SET_ENERGY_LOG_CONFIGURATION = 44
+FUNCTION_GET_ENERGY_LOG_CONFIGURATION = 45
+FUNCTION_SET_ENERGY_LOG_VALUES = 46
+FUNCTION_SET_ENERGY_LOG_DAILY_VALUES = 47
+FUNCTION_GET_ENERGY_LOG_STATE = 48
+
+POWER_UNKNOWN = 2**31 - 1
+ENERGY_UNKNOWN = 2**32 - 1
+DAILY_ENERGY_UNIT = 10 # Wh, same as the daily data points of the esp32-firmware
+
+# Usage: energy_log.py [enable|disable]
+# The configuration is stored in the EEPROM and survives a restart of the Bricklet
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_SET_ENERGY_LOG_CONFIGURATION] = em.RESPONSE_EXPECTED_FALSE
+    em.response_expected[FUNCTION_GET_ENERGY_LOG_CONFIGURATION] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+    em.response_expected[FUNCTION_SET_ENERGY_LOG_VALUES] = em.RESPONSE_EXPECTED_FALSE
+    em.response_expected[FUNCTION_SET_ENERGY_LOG_DAILY_VALUES] = em.RESPONSE_EXPECTED_FALSE
+    em.response_expected[FUNCTION_GET_ENERGY_LOG_STATE] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+
+    if len(sys.argv) > 1:
+        enable = sys.argv[1] == 'enable'
+        if enable:
+            # The data points are written from the RTC, it has to be set first
+            em.set_date_time(0, 0, 12, 0, 0, 0, 2024)
+            em.ipcon.send_request(em, FUNCTION_SET_ENERGY_LOG_VALUES, (0, [POWER_UNKNOWN]*6, 0), 'B 6i I', 0, '')
+            em.ipcon.send_request(em, FUNCTION_SET_ENERGY_LOG_DAILY_VALUES, ([ENERGY_UNKNOWN]*6, [ENERGY_UNKNOWN]*6, 0), '6I 6I I', 0, '')
+        em.ipcon.send_request(em, FUNCTION_SET_ENERGY_LOG_CONFIGURATION, (enable, DAILY_ENERGY_UNIT), '! H', 0, '')
+
+    enable, daily_energy_unit = em.ipcon.send_request(em, FUNCTION_GET_ENERGY_LOG_CONFIGURATION, (), '', 11, '! H')
+    active, power_grid, slot_covered, energy_in, energy_out, written, dropped, pending = em.ipcon.send_request(em, FUNCTION_GET_ENERGY_LOG_STATE, (), '', 34, '! i I I I I I B')
+
+    print('enable {0}, active {1}, daily energy unit {2} Wh'.format(enable, active, daily_energy_unit))
+    print('5 minute slot: power grid {0} W over {1} ms'.format('-' if power_grid == POWER_UNKNOWN else power_grid, slot_covered))
+    print('today: energy grid in {0:.2f} kWh, out {1:.2f} kWh'.format(energy_in*daily_energy_unit/1000, energy_out*daily_energy_unit/1000))
+    print('data points: written {0}, dropped {1}, pending {2}'.format(written, dropped, pending))
@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '26dL'
+
+import struct
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_GET_ALL_DATA_CHANGES = 43
+
+# Group name, payload format (in order of the changed bits)
+GROUPS = [
+    ('contactor',       '<B'),
+    ('led',             '<BBBBH'),
+    ('meter_values',    '<ffff'),
+    ('input',           '<B'),
+    ('output',          '<B'),
+    ('voltage',         '<H'),
+    ('contactor_check', '<B'),
+    ('sd_queue',        '<4B'),
+    ('data_storage',    '<BBB'),
+]
+
+# Polls with the last sequence number and prints only what changed
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_GET_ALL_DATA_CHANGES] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+
+    sequence = 0
+    while True:
+        sequence, changed, resync, data = em.ipcon.send_request(em, FUNCTION_GET_ALL_DATA_CHANGES, (sequence,), 'I', 50, 'I H ! 35B')
+        if resync:
+            print('{0:>10} resync'.format(sequence))
+
+        raw = bytes(data)
+        pos = 0
+        for i, (name, fmt) in enumerate(GROUPS):
+            if changed & (1 << i):
+                print('{0:>10} {1:>16}: {2}'.format(sequence, name, struct.unpack_from(fmt, raw, pos)))
+            pos += struct.calcsize(fmt)
+
+        time.sleep(0.1)
@@ -0,0 +1,36 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '26dL'
+
+import sys
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_GET_FID_STATISTICS = 42
+FUNCTION_RESET_FID_STATISTICS = 58
+FID_NUM = 59
+HISTOGRAM = ['< 10us', '< 80us', '< 640us', '>= 640us']
+
+# Calls, length rejects and handler durations per FID since the last
+# reset_fid_statistics (get_fid_statistics.py reset). FID 0 counts unknown FIDs.
+# Only counted if the firmware is built with COMMUNICATION_FID_STATISTICS.
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_GET_FID_STATISTICS] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+    em.response_expected[FUNCTION_RESET_FID_STATISTICS] = em.RESPONSE_EXPECTED_FALSE
+
+    print('{0:>4} {1:>10} {2:>8} {3:>8} '.format('fid', 'calls', 'invalid', 'max us') + ' '.join('{0:>9}'.format(h) for h in HISTOGRAM))
+    for fid in range(FID_NUM):
+        calls, invalid_length, max_us, histogram = em.ipcon.send_request(em, FUNCTION_GET_FID_STATISTICS, (fid,), 'B', 28, 'I I I 4H')
+        if calls > 0:
+            print('{0:>4} {1:>10} {2:>8} {3:>8} '.format(fid, calls, invalid_length, max_us) + ' '.join('{0:>9}'.format(h) for h in histogram))
+
+    if len(sys.argv) > 1 and sys.argv[1] == 'reset':
+        em.ipcon.send_request(em, FUNCTION_RESET_FID_STATISTICS, (), '', 0, '')
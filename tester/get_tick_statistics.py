@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '26dL'
+
+import sys
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_GET_TICK_STATISTICS = 36
+FUNCTION_GET_LOOP_STATISTICS = 37
+FUNCTION_RESET_TICK_STATISTICS = 38
+
+TICKS = ['bootloader', 'communication', 'io', 'led', 'rs485', 'meter', 'voltage', 'date_time', 'sd', 'data_storage', 'sd_queue', 'energy_log', 'voltage_monitor']
+HISTOGRAM_BASE_US = 32
+
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_GET_TICK_STATISTICS] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+    em.response_expected[FUNCTION_GET_LOOP_STATISTICS] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+    em.response_expected[FUNCTION_RESET_TICK_STATISTICS] = em.RESPONSE_EXPECTED_FALSE
+
+    print('{0:>14} {1:>10} {2:>8} {3:>8} {4:>8}'.format('tick', 'count', 'min us', 'avg us', 'max us'))
+    for i, name in enumerate(TICKS):
+        count, min_us, avg_us, max_us = em.ipcon.send_request(em, FUNCTION_GET_TICK_STATISTICS, (i,), 'B', 24, 'I I I I')
+        print('{0:>14} {1:>10} {2:>8} {3:>8} {4:>8}'.format(name, count, min_us, avg_us, max_us))
+
+    ret = em.ipcon.send_request(em, FUNCTION_GET_LOOP_STATISTICS, (), '', 72, 'I I I I 12I')
+    count, min_us, avg_us, max_us = ret[:4]
+    print('{0:>14} {1:>10} {2:>8} {3:>8} {4:>8}'.format('loop', count, min_us, avg_us, max_us))
+
+    print('\nloop duration histogram')
+    for i, value in enumerate(ret[4]):
+        if i < len(ret[4]) - 1:
+            print('{0:>14} {1:>10}'.format('< {0} us'.format(HISTOGRAM_BASE_US << i), value))
+        else:
+            print('{0:>14} {1:>10}'.format('>= {0} us'.format(HISTOGRAM_BASE_US << (i - 1)), value))
+
+    if len(sys.argv) > 1 and sys.argv[1] == 'reset':
+        em.ipcon.send_request(em, FUNCTION_RESET_TICK_STATISTICS, (), '', 0, '')
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '26dL'
+
+import sys
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_START_IO_SEQUENCE = 49
+FUNCTION_ABORT_IO_SEQUENCE = 50
+FUNCTION_GET_IO_SEQUENCE_STATE = 51
+CALLBACK_IO_SEQUENCE_DONE = 52
+
+SET_CONTACTOR = 0
+SET_OUTPUT = 1
+WAIT = 2
+VERIFY_CONTACTOR = 3
+
+STEP_NUM = 16
+RESULTS = ['ok', 'contactor check failed', 'timeout', 'aborted']
+
+# 3 phase -> 1 phase -> 3 phase: contactor off, let it settle, pause, contactor on
+SEQUENCE = [
+    (SET_CONTACTOR, 0),
+    (VERIFY_CONTACTOR, 1500),
+    (WAIT, 5000),
+    (SET_CONTACTOR, 1),
+    (VERIFY_CONTACTOR, 1500),
+]
+
+done = False
+
+def cb_io_sequence_done(result, step, duration):
+    global done
+    print('done after {0} ms: {1} (step {2})'.format(duration, RESULTS[result], step))
+    done = True
+
+# io_sequence.py [abort]
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_START_IO_SEQUENCE] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+    em.response_expected[FUNCTION_ABORT_IO_SEQUENCE] = em.RESPONSE_EXPECTED_TRUE
+    em.response_expected[FUNCTION_GET_IO_SEQUENCE_STATE] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+    em.callback_formats[CALLBACK_IO_SEQUENCE_DONE] = (14, 'B B I')
+    em.register_callback(CALLBACK_IO_SEQUENCE_DONE, cb_io_sequence_done)
+
+    if len(sys.argv) > 1 and sys.argv[1] == 'abort':
+        em.ipcon.send_request(em, FUNCTION_ABORT_IO_SEQUENCE, (), '', 8, '')
+        ipcon.disconnect()
+        sys.exit(0)
+
+    commands = [c for c, _ in SEQUENCE] + [0]*(STEP_NUM - len(SEQUENCE))
+    arguments = [a for _, a in SEQUENCE] + [0]*(STEP_NUM - len(SEQUENCE))
+    status = em.ipcon.send_request(em, FUNCTION_START_IO_SEQUENCE, (len(SEQUENCE), commands, arguments), 'B 16B 16H', 9, 'B')
+    if status != 0:
+        print('sequence already running')
+    else:
+        while not done:
+            running, step, result, result_step, duration = em.ipcon.send_request(em, FUNCTION_GET_IO_SEQUENCE_STATE, (), '', 16, '! B B B I')
+            print('running {0}, step {1}'.format(running, step))
+            time.sleep(0.5)
+
+    ipcon.disconnect()
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '26dL'
+
+import sys
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_SET_LED_SEQUENCE = 53
+FUNCTION_GET_LED_SEQUENCE = 54
+
+KEYFRAME_NUM = 10
+
+# Keyframes are (r, g, b, fade, duration ms), fade ramps from the previous keyframe's color
+SEQUENCES = {
+    # Blink red three times, then stay off
+    'blink3': (3, [(255, 0, 0, False, 200), (0, 0, 0, False, 200)]),
+    # Error code: two long and one short blink in red, then a pause
+    'error': (0, [(255, 0, 0, False, 600), (0, 0, 0, False, 300), (255, 0, 0, False, 600), (0, 0, 0, False, 300),
+                  (255, 0, 0, False, 200), (0, 0, 0, False, 1500)]),
+    # Fade green -> blue -> green
+    'fade': (0, [(0, 255, 0, True, 2000), (0, 0, 255, True, 2000)]),
+}
+
+# led_sequence.py [blink3|error|fade]
+if __name__ == '__main__':
+    name = sys.argv[1] if len(sys.argv) > 1 else 'error'
+    repeat, keyframes = SEQUENCES[name]
+    keyframes = keyframes + [(0, 0, 0, False, 0)]*(KEYFRAME_NUM - len(keyframes))
+
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_SET_LED_SEQUENCE] = em.RESPONSE_EXPECTED_TRUE
+    em.response_expected[FUNCTION_GET_LED_SEQUENCE] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+
+    length = len(SEQUENCES[name][1])
+    r, g, b, fade, duration = [list(x) for x in zip(*keyframes)]
+    em.ipcon.send_request(em, FUNCTION_SET_LED_SEQUENCE, (length, repeat, r, g, b, fade, duration), 'B B 10B 10B 10B 10! 10H', 8, '')
+
+    ret = em.ipcon.send_request(em, FUNCTION_GET_LED_SEQUENCE, (), '', 62, 'B B 10B 10B 10B 10! 10H')
+    length, repeat, r, g, b, fade, duration = ret
+    print('{0} keyframes, repeat {1}'.format(length, repeat))
+    for i in range(length):
+        print('{0:>2}: rgb({1:>3}, {2:>3}, {3:>3}) {4:>5} ms{5}'.format(i, r[i], g[i], b[i], duration[i], ' fade' if fade[i] else ''))
+
+    ipcon.disconnect()
@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '256GKn'
+
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_CANCEL_SD_DATA_POINTS = 41
+DATA_POINTS_TYPE_ENERGY_MANAGER = 2
+
+received = []
+
+def cb_energy_manager_data_points(data):
+    received.append(len(data))
+
+# Simulates fast flipping between days: Every query is cancelled right away
+# except the last one, only the stream of the last query should arrive
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_CANCEL_SD_DATA_POINTS] = em.RESPONSE_EXPECTED_TRUE
+    em.register_callback(em.CALLBACK_SD_ENERGY_MANAGER_DATA_POINTS, cb_energy_manager_data_points)
+
+    t = time.time()
+    for day in range(1, 6):
+        status = em.get_sd_energy_manager_data_points(22, 1, day, 0, 0, 288)
+        print('day {0}: status {1} after {2:.1f} ms'.format(day, status, (time.time() - t)*1000))
+        if day < 5:
+            em.ipcon.send_request(em, FUNCTION_CANCEL_SD_DATA_POINTS, (DATA_POINTS_TYPE_ENERGY_MANAGER,), 'B', 8, '')
+
+    while len(received) == 0:
+        time.sleep(0.001)
+
+    time.sleep(1)
+    print('{0} stream(s) received, last stream complete after {1:.1f} ms'.format(len(received), (time.time() - t - 1)*1000))
@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '256GKn'
+
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_GET_SD_QUEUE_STATUS = 40
+
+QUEUES = ['wallbox', 'wallbox_daily', 'energy_manager', 'energy_manager_daily']
+
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_GET_SD_QUEUE_STATUS] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+
+    while True:
+        fill, capacity, oldest_age, last_flush_duration = em.ipcon.send_request(em, FUNCTION_GET_SD_QUEUE_STATUS, (), '', 48, '4B 4B 4I 4I')
+        for i, name in enumerate(QUEUES):
+            print('{0:>20}: {1:>2}/{2:<2} oldest {3:>6} ms, last flush {4:>6} ms'.format(name, fill[i], capacity[i], oldest_age[i], last_flush_duration[i]))
+        print('')
+        time.sleep(1)
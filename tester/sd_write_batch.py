@@ -0,0 +1,38 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '256GKn'
+
+import sys
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_SET_SD_WALLBOX_DATA_POINTS = 39
+SET_SD_WALLBOX_DATA_POINTS_MAX = 8
+
+# Writes one 5 minute data point for each of N wallboxes (default 32),
+# 8 wallboxes per call instead of one call per wallbox
+if __name__ == '__main__':
+    wallboxes = int(sys.argv[1]) if len(sys.argv) > 1 else 32
+
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_SET_SD_WALLBOX_DATA_POINTS] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+
+    year, month, day, hour, minute = 24, 1, 11, 14, 40
+    for start in range(1, wallboxes + 1, SET_SD_WALLBOX_DATA_POINTS_MAX):
+        ids = list(range(start, min(start + SET_SD_WALLBOX_DATA_POINTS_MAX, wallboxes + 1)))
+        length = len(ids)
+        pad = [0] * (SET_SD_WALLBOX_DATA_POINTS_MAX - length)
+        flags = [1] * length
+        power = [1000 + i for i in ids]
+
+        status, accepted = em.ipcon.send_request(em, FUNCTION_SET_SD_WALLBOX_DATA_POINTS,
+                                                 (year, month, day, hour, minute, length, ids + pad, flags + pad, power + pad),
+                                                 'B B B B B B 8I 8B 8H', 10, 'B B')
+        print('wallboxes {0}: status {1}, accepted {2:08b}'.format(ids, status, accepted))
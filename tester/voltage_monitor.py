@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '26dL'
+
+import sys
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager import BrickletWARPEnergyManager
+
+# Not yet part of the generated bindings
+FUNCTION_SET_VOLTAGE_MONITOR_CONFIGURATION = 55
+FUNCTION_GET_VOLTAGE_MONITOR_CONFIGURATION = 56
+FUNCTION_GET_VOLTAGE_MONITOR_STATISTICS = 57
+
+# voltage_monitor.py [brown-out threshold mV, 0 = off] [window ms]
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManager(EM_UID, ipcon)
+    em.response_expected[FUNCTION_SET_VOLTAGE_MONITOR_CONFIGURATION] = em.RESPONSE_EXPECTED_TRUE
+    em.response_expected[FUNCTION_GET_VOLTAGE_MONITOR_CONFIGURATION] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+    em.response_expected[FUNCTION_GET_VOLTAGE_MONITOR_STATISTICS] = em.RESPONSE_EXPECTED_ALWAYS_TRUE
+
+    if len(sys.argv) > 1:
+        threshold = int(sys.argv[1])
+        window = int(sys.argv[2]) if len(sys.argv) > 2 else 1000
+        em.ipcon.send_request(em, FUNCTION_SET_VOLTAGE_MONITOR_CONFIGURATION, (threshold, window), 'H H', 8, '')
+
+    threshold, window = em.ipcon.send_request(em, FUNCTION_GET_VOLTAGE_MONITOR_CONFIGURATION, (), '', 12, 'H H')
+    print('brown-out threshold {0} mV, window {1} ms'.format(threshold, window))
+
+    try:
+        while True:
+            valid, min_mv, max_mv, avg_mv, brown_out, brown_out_count = em.ipcon.send_request(em, FUNCTION_GET_VOLTAGE_MONITOR_STATISTICS, (), '', 20, '! H H H ! I')
+            if valid:
+                print('min {0} mV, max {1} mV, avg {2} mV, brown-out {3} (count {4})'.format(min_mv, max_mv, avg_mv, brown_out, brown_out_count))
+            else:
+                print('no measurement yet')
+            time.sleep(max(window, 1000) / 1000)
+    except KeyboardInterrupt:
+        pass
+
+    ipcon.disconnect()